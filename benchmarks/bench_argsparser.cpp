@@ -0,0 +1,672 @@
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "argsparser.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>  // For perf_event_attr
+#include <sys/ioctl.h>         // For ioctl
+#include <sys/syscall.h>       // For SYS_perf_event_open
+#include <unistd.h>            // For syscall, read, close
+#define BENCH_HAS_PERF_EVENTS 1
+#else
+#define BENCH_HAS_PERF_EVENTS 0
+#endif
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Keeps a value alive so the optimizer cannot drop the work behind it
+ */
+template <typename T>
+void keep(const T& value) {
+  static volatile std::uint64_t sink = 0;
+  sink = sink + static_cast<std::uint64_t>(value);
+}
+
+/**
+ * @brief Result of timing one scenario
+ */
+struct Measurement {
+  std::uint64_t iterations{0};
+  double totalNanoseconds{0.0};
+
+  [[nodiscard]] double nanosecondsPerIteration() const {
+    return iterations == 0 ? 0.0
+                           : totalNanoseconds / static_cast<double>(iterations);
+  }
+};
+
+/**
+ * @brief Run a callable repeatedly until at least minTime has elapsed
+ *
+ * The callable runs in batches whose size doubles until the batch takes long
+ * enough, so clock overhead stays negligible even for very cheap operations.
+ */
+template <typename F>
+Measurement measure(F&& body, std::chrono::milliseconds minTime) {
+  body();  // Warm up caches and lazily built indexes
+
+  Measurement result;
+  std::uint64_t batch = 1;
+  const auto deadline = Clock::now() + minTime;
+  while (Clock::now() < deadline) {
+    const auto start = Clock::now();
+    for (std::uint64_t i = 0; i < batch; ++i) {
+      body();
+    }
+    const auto elapsed = Clock::now() - start;
+    result.iterations += batch;
+    result.totalNanoseconds += static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    if (elapsed < minTime / 10) {
+      batch *= 2;
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Hardware performance counters read around a scenario
+ *
+ * Uses Linux perf_event_open for user-space instructions, cycles, branch
+ * misses, L1 data cache read misses and last-level cache misses. Each counter
+ * is opened on its own, so a counter the CPU or kernel does not offer (or
+ * that perf_event_paranoid forbids) is skipped rather than disabling all of
+ * them. On other platforms no counter is ever available.
+ */
+class PerfCounters {
+ public:
+  static constexpr std::size_t kCount = 5;
+  static constexpr std::array<const char*, kCount> kNames = {
+      "instructions", "cycles", "branch_misses", "l1d_misses", "llc_misses"};
+
+ private:
+  std::array<int, kCount> fds_{};
+  std::array<std::uint64_t, kCount> values_{};
+  int openError_{ENOSYS};
+
+ public:
+  PerfCounters() {
+    fds_.fill(-1);
+#if BENCH_HAS_PERF_EVENTS
+    constexpr std::uint64_t l1dReadMiss =
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const std::array<std::pair<std::uint32_t, std::uint64_t>, kCount> events =
+        {{{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+          {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+          {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+          {PERF_TYPE_HW_CACHE, l1dReadMiss},
+          {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}}};
+    for (std::size_t i = 0; i < kCount; ++i) {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = events[i].first;
+      attr.config = events[i].second;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fds_[i] = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (fds_[i] < 0) {
+        openError_ = errno;
+      }
+    }
+#endif
+  }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  PerfCounters(PerfCounters&&) = delete;
+  PerfCounters& operator=(PerfCounters&&) = delete;
+
+  ~PerfCounters() {
+#if BENCH_HAS_PERF_EVENTS
+    for (const int fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief Whether at least one counter could be opened
+   */
+  [[nodiscard]] bool anyAvailable() const {
+    for (const int fd : fds_) {
+      if (fd >= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief The errno of the last counter that failed to open
+   */
+  [[nodiscard]] int openError() const { return openError_; }
+
+  /**
+   * @brief Whether counter i could be opened
+   */
+  [[nodiscard]] bool available(std::size_t i) const { return fds_[i] >= 0; }
+
+  /**
+   * @brief Reset and start all available counters
+   */
+  void start() {
+#if BENCH_HAS_PERF_EVENTS
+    for (const int fd : fds_) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief Stop all available counters and latch their values
+   */
+  void stop() {
+#if BENCH_HAS_PERF_EVENTS
+    for (std::size_t i = 0; i < kCount; ++i) {
+      values_[i] = 0;
+      if (fds_[i] < 0) {
+        continue;
+      }
+      ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+      std::uint64_t value = 0;
+      if (read(fds_[i], &value, sizeof(value)) ==
+          static_cast<ssize_t>(sizeof(value))) {
+        values_[i] = value;
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief The value of counter i latched by the last stop()
+   */
+  [[nodiscard]] std::uint64_t value(std::size_t i) const { return values_[i]; }
+};
+
+/**
+ * @brief A parser populated with a generated schema
+ *
+ * A quarter of the options each are flags, strings, 32-bit integers and
+ * doubles. The first flags get single-letter short names so they can be
+ * grouped, and two positional arguments are registered.
+ */
+struct Schema {
+  argsparser::Parser parser{"bench", "Generated benchmark schema"};
+  std::size_t flags{0};
+  std::size_t strings{0};
+  std::size_t integers{0};
+  std::size_t doubles{0};
+
+  explicit Schema(std::size_t optionCount) {
+    flags = (optionCount + 3) / 4;
+    strings = (optionCount + 2) / 4;
+    integers = (optionCount + 1) / 4;
+    doubles = optionCount / 4;
+
+    for (std::size_t i = 0; i < flags; ++i) {
+      const std::string shortName =
+          i < 26 ? std::string(1, static_cast<char>('a' + i)) : "";
+      parser.addArgument<bool>("flag-" + std::to_string(i), shortName,
+                               "Generated flag");
+    }
+    for (std::size_t i = 0; i < strings; ++i) {
+      parser.addArgument<std::string>("str-" + std::to_string(i), "",
+                                      "Generated string option", false,
+                                      "default");
+    }
+    for (std::size_t i = 0; i < integers; ++i) {
+      parser.addArgument<int32_t>("int-" + std::to_string(i), "",
+                                  "Generated integer option", false, 1);
+    }
+    for (std::size_t i = 0; i < doubles; ++i) {
+      parser.addArgument<double>("dbl-" + std::to_string(i), "",
+                                 "Generated double option", false, 0.5);
+    }
+    parser.addPositionalArgument<std::string>("source", "Source", false);
+    parser.addPositionalArgument<std::string>("dest", "Destination", false);
+  }
+};
+
+/// Number of tokens (excluding argv[0]) in each generated command line
+constexpr std::size_t kTokensPerArgv = 32;
+
+/**
+ * @brief Build a command line for one token mix
+ *
+ * @param schema The schema the command line targets
+ * @param mix One of "flags", "grouped", "key_value", "numeric",
+ * "positional"
+ * @return The tokens, starting with the program name
+ */
+std::vector<std::string> makeTokens(const Schema& schema,
+                                    const std::string& mix) {
+  std::vector<std::string> tokens{"bench"};
+  std::size_t i = 0;
+  while (tokens.size() - 1 < kTokensPerArgv) {
+    if (mix == "flags") {
+      tokens.push_back("--flag-" + std::to_string(i % schema.flags));
+    } else if (mix == "grouped") {
+      const std::size_t letters = std::min<std::size_t>(schema.flags, 8);
+      std::string group = "-";
+      for (std::size_t j = 0; j < letters; ++j) {
+        group += static_cast<char>('a' + j);
+      }
+      tokens.push_back(group);
+    } else if (mix == "key_value") {
+      tokens.push_back("--str-" + std::to_string(i % schema.strings) +
+                       "=value" + std::to_string(i));
+    } else if (mix == "numeric") {
+      if (i % 2 == 0) {
+        tokens.push_back("--int-" + std::to_string(i % schema.integers));
+        tokens.push_back(std::to_string(1000 + i));
+      } else {
+        tokens.push_back("--dbl-" + std::to_string(i % schema.doubles));
+        tokens.push_back("3.25e" + std::to_string(i % 8));
+      }
+    } else if (mix == "positional") {
+      // Two positional values surrounded by --k=v options
+      if (i < 2) {
+        tokens.push_back(i == 0 ? "input.txt" : "output.txt");
+      } else {
+        tokens.push_back("--str-" + std::to_string(i % schema.strings) + "=x");
+      }
+    }
+    ++i;
+  }
+  tokens.resize(kTokensPerArgv + 1);
+  return tokens;
+}
+
+/**
+ * @brief Minimal JSON writer for the flat result records
+ */
+class JsonResults {
+ private:
+  std::ostream& os_;
+  bool first_{true};
+
+ public:
+  explicit JsonResults(std::ostream& os) : os_(os) {
+    os_ << "{\n  \"benchmark\": \"argsparser\",\n  \"results\": [";
+  }
+
+  JsonResults(const JsonResults&) = delete;
+  JsonResults& operator=(const JsonResults&) = delete;
+  JsonResults(JsonResults&&) = delete;
+  JsonResults& operator=(JsonResults&&) = delete;
+
+  ~JsonResults() { os_ << "\n  ]\n}\n"; }
+
+  /**
+   * @brief Start a result record
+   * @param name The scenario name
+   */
+  JsonResults& begin(const std::string& name) {
+    os_ << (first_ ? "\n" : ",\n") << "    {\"name\": \"" << name << "\"";
+    first_ = false;
+    return *this;
+  }
+
+  JsonResults& field(const char* key, const std::string& value) {
+    os_ << ", \"" << key << "\": \"" << value << "\"";
+    return *this;
+  }
+
+  JsonResults& field(const char* key, double value) {
+    os_ << ", \"" << key << "\": " << value;
+    return *this;
+  }
+
+  JsonResults& field(const char* key, std::uint64_t value) {
+    os_ << ", \"" << key << "\": " << value;
+    return *this;
+  }
+
+  void end() { os_ << "}"; }
+};
+
+void benchParse(Schema& schema, std::size_t optionCount,
+                std::chrono::milliseconds minTime, PerfCounters* counters,
+                JsonResults& json) {
+  static const char* const kMixes[] = {"flags", "grouped", "key_value",
+                                       "numeric", "positional"};
+  for (const char* mix : kMixes) {
+    const std::vector<std::string> tokens = makeTokens(schema, mix);
+    std::vector<char*> argv;
+    argv.reserve(tokens.size());
+    for (const auto& token : tokens) {
+      argv.push_back(const_cast<char*>(token.c_str()));
+    }
+    const int argc = static_cast<int>(argv.size());
+
+    argsparser::ParseResult result = argsparser::ParseResult::SUCCESS;
+    if (counters != nullptr) {
+      counters->start();
+    }
+    const Measurement m = measure(
+        [&] {
+          result = schema.parser.parse(argc, argv.data(), nullptr);
+          keep(static_cast<int>(result));
+        },
+        minTime);
+    if (counters != nullptr) {
+      counters->stop();
+    }
+    if (result != argsparser::ParseResult::SUCCESS) {
+      std::cerr << "parse failed for mix " << mix << ": "
+                << schema.parser.getLastError() << "\n";
+    }
+
+    const double perArgv = m.nanosecondsPerIteration();
+    json.begin("parse")
+        .field("options", static_cast<std::uint64_t>(optionCount))
+        .field("mix", std::string(mix))
+        .field("tokens", static_cast<std::uint64_t>(kTokensPerArgv))
+        .field("iterations", m.iterations)
+        .field("ns_per_argv", perArgv)
+        .field("ns_per_token", perArgv / static_cast<double>(kTokensPerArgv))
+        .field("argv_per_second", perArgv > 0.0 ? 1e9 / perArgv : 0.0);
+    if (counters != nullptr) {
+      // Counters also ran for the warm-up call inside measure()
+      const double tokens = static_cast<double>(m.iterations + 1) *
+                            static_cast<double>(kTokensPerArgv);
+      for (std::size_t i = 0; i < PerfCounters::kCount; ++i) {
+        if (counters->available(i)) {
+          json.field(
+              (std::string(PerfCounters::kNames[i]) + "_per_token").c_str(),
+              static_cast<double>(counters->value(i)) / tokens);
+        }
+      }
+    }
+    json.end();
+  }
+}
+
+void benchHelp(Schema& schema, std::size_t optionCount,
+               std::chrono::milliseconds minTime, JsonResults& json) {
+  std::ostringstream out;
+  const Measurement m = measure(
+      [&] {
+        out.str(std::string());
+        schema.parser.printHelp(out);
+        keep(out.tellp());
+      },
+      minTime);
+  json.begin("help")
+      .field("options", static_cast<std::uint64_t>(optionCount))
+      .field("iterations", m.iterations)
+      .field("ns_per_call", m.nanosecondsPerIteration())
+      .field("bytes", static_cast<std::uint64_t>(out.str().size()))
+      .end();
+}
+
+/**
+ * @brief Value access: getValue<T>(name), an ArgumentHandle resolved once,
+ * and a plain member load through a pointer as the baseline
+ */
+void benchGetValue(Schema& schema, std::size_t optionCount,
+                   std::chrono::milliseconds minTime, JsonResults& json) {
+  struct Plain {
+    int32_t value{1};
+  };
+  std::vector<std::string> names;
+  std::vector<argsparser::ArgumentHandle<int32_t>> handles;
+  std::vector<std::unique_ptr<Plain>> plain;
+  for (std::size_t i = 0; i < schema.integers; ++i) {
+    names.push_back("int-" + std::to_string(i));
+    handles.push_back(schema.parser.getHandle<int32_t>(names.back()));
+    plain.push_back(std::make_unique<Plain>());
+  }
+  std::size_t next = 0;
+  auto advance = [&] { next = next + 1 == names.size() ? 0 : next + 1; };
+  const Measurement byName = measure(
+      [&] {
+        keep(schema.parser.getValue<int32_t>(names[next]));
+        advance();
+      },
+      minTime);
+  const Measurement byHandle = measure(
+      [&] {
+        keep(handles[next].getValue());
+        advance();
+      },
+      minTime);
+  const Measurement byMember = measure(
+      [&] {
+        keep(plain[next]->value);
+        advance();
+      },
+      minTime);
+  const std::pair<const char*, const Measurement*> methods[] = {
+      {"name", &byName}, {"handle", &byHandle}, {"member", &byMember}};
+  for (const auto& method : methods) {
+    json.begin("get_value")
+        .field("options", static_cast<std::uint64_t>(optionCount))
+        .field("method", std::string(method.first))
+        .field("iterations", method.second->iterations)
+        .field("ns_per_lookup", method.second->nanosecondsPerIteration())
+        .end();
+  }
+}
+
+/**
+ * @brief Registration cost: addArgument() one at a time, one addArguments()
+ * descriptor table, and attaching a schema frozen with freezeSchema()
+ */
+void benchRegistration(std::size_t optionCount,
+                       std::chrono::milliseconds minTime, JsonResults& json) {
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < optionCount; ++i) {
+    names.push_back("opt-" + std::to_string(i));
+  }
+  std::vector<argsparser::ArgumentDescriptor> table;
+  for (std::size_t i = 0; i < optionCount; ++i) {
+    table.push_back({i % 2 == 0 ? argsparser::ArgumentType::INT32
+                                : argsparser::ArgumentType::BOOL,
+                     names[i].c_str(), nullptr, "Generated option", false,
+                     nullptr});
+  }
+
+  const Measurement single = measure(
+      [&] {
+        argsparser::Parser parser("bench", "Registration");
+        for (std::size_t i = 0; i < optionCount; ++i) {
+          if (i % 2 == 0) {
+            parser.addArgument<int32_t>(names[i], "", "Generated option");
+          } else {
+            parser.addArgument<bool>(names[i], "", "Generated option");
+          }
+        }
+        keep(parser.getLastError().size());
+      },
+      minTime);
+  const Measurement bulk = measure(
+      [&] {
+        argsparser::Parser parser("bench", "Registration");
+        keep(static_cast<int>(
+            parser.addArguments(table.data(), table.size(),
+                                argsparser::StringStorage::REFERENCE)));
+      },
+      minTime);
+
+  std::string blob;
+  {
+    argsparser::Parser parser("bench", "Registration");
+    parser.addArguments(table.data(), table.size());
+    parser.freezeSchema(blob);
+  }
+  const Measurement frozen = measure(
+      [&] {
+        argsparser::FrozenSchema schema;
+        keep(static_cast<int>(schema.attach(blob)));
+      },
+      minTime);
+
+  for (const auto& [method, m] :
+       {std::make_pair("add_argument", single), std::make_pair("bulk", bulk),
+        std::make_pair("frozen", frozen)}) {
+    json.begin("registration")
+        .field("options", static_cast<std::uint64_t>(optionCount))
+        .field("method", std::string(method))
+        .field("iterations", m.iterations)
+        .field("ns_per_option", m.nanosecondsPerIteration() /
+                                    static_cast<double>(optionCount))
+        .end();
+  }
+}
+
+/**
+ * @brief Feature-flag scale: many boolean options, packed versus classic
+ *
+ * Registers flagCount "--feature-N" flags either as packed flags or as
+ * Argument<bool> objects, then times registration, parsing a command line of
+ * flags and name lookups. Packed flags also report their memory per flag.
+ */
+void benchFlagScale(std::size_t flagCount, bool packed,
+                    std::chrono::milliseconds minTime, JsonResults& json) {
+  std::vector<std::string> names;
+  names.reserve(flagCount);
+  std::size_t nameBytes = 0;
+  for (std::size_t i = 0; i < flagCount; ++i) {
+    names.push_back("feature-" + std::to_string(i));
+    nameBytes += names.back().size();
+  }
+
+  argsparser::Parser parser("bench", "Feature flag schema");
+  const auto registrationStart = Clock::now();
+  if (packed) {
+    parser.reservePackedFlags(flagCount, nameBytes);
+    for (const auto& name : names) {
+      parser.addPackedFlag(name);
+    }
+  } else {
+    for (const auto& name : names) {
+      parser.addArgument<bool>(name, "", "Generated feature flag");
+    }
+  }
+  const double registrationNanoseconds = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           registrationStart)
+          .count());
+
+  // Flags spread across the whole schema
+  std::vector<std::string> tokens{"bench"};
+  for (std::size_t i = 0; i < kTokensPerArgv; ++i) {
+    tokens.push_back("--" + names[(i * 7919) % flagCount]);
+  }
+  std::vector<char*> argv;
+  argv.reserve(tokens.size());
+  for (const auto& token : tokens) {
+    argv.push_back(const_cast<char*>(token.c_str()));
+  }
+  const int argc = static_cast<int>(argv.size());
+
+  const Measurement parse = measure(
+      [&] { keep(static_cast<int>(parser.parse(argc, argv.data(), nullptr))); },
+      minTime);
+
+  std::size_t next = 0;
+  const Measurement lookup = measure(
+      [&] {
+        keep(static_cast<int>(parser.isSet(names[next])));
+        next = next + 1 == names.size() ? 0 : next + 1;
+      },
+      minTime);
+
+  json.begin("flag_scale")
+      .field("flags", static_cast<std::uint64_t>(flagCount))
+      .field("storage", std::string(packed ? "packed" : "argument"))
+      .field("registration_ns_per_flag",
+             registrationNanoseconds / static_cast<double>(flagCount))
+      .field("ns_per_token", parse.nanosecondsPerIteration() /
+                                 static_cast<double>(kTokensPerArgv))
+      .field("ns_per_is_set", lookup.nanosecondsPerIteration());
+  if (packed) {
+    json.field("bytes_per_flag",
+               static_cast<double>(parser.getPackedFlags().memoryUsage()) /
+                   static_cast<double>(flagCount));
+  }
+  json.end();
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  argsparser::Parser cli("bench_argsparser",
+                         "Microbenchmarks for argsparser; prints JSON");
+  auto* minTimeMs = cli.addArgument<uint32_t>(
+      "min-time-ms", "t", "Minimum measuring time per scenario", false, 200U);
+  auto* maxOptions = cli.addArgument<uint32_t>(
+      "max-options", "m", "Skip schemas larger than this", false, 10000U);
+  auto* maxFlags = cli.addArgument<uint32_t>(
+      "max-flags", "f", "Skip feature-flag schemas larger than this", false,
+      100000U);
+  auto* perfCounters = cli.addArgument<bool>(
+      "perf-counters", "p",
+      "Report hardware counters per token for parse scenarios (Linux)");
+
+  switch (cli.parse(argc, argv)) {
+    case argsparser::ParseResult::SUCCESS:
+      break;
+    case argsparser::ParseResult::HELP_REQUESTED:
+      cli.printHelp();
+      return 0;
+    default:
+      std::cerr << "Error: " << cli.getLastError() << "\n";
+      return 1;
+  }
+
+  const std::chrono::milliseconds minTime(minTimeMs->getValue());
+  PerfCounters counters;
+  PerfCounters* activeCounters = nullptr;
+  if (perfCounters->getValue()) {
+    if (counters.anyAvailable()) {
+      activeCounters = &counters;
+    } else {
+      std::cerr << "warning: hardware counters unavailable ("
+                << std::strerror(counters.openError())
+                << "); reporting wall-clock time only\n";
+    }
+  }
+  JsonResults json(std::cout);
+  for (const std::size_t optionCount : {10U, 100U, 10000U}) {
+    if (optionCount > maxOptions->getValue()) {
+      continue;
+    }
+    Schema schema(optionCount);
+    benchParse(schema, optionCount, minTime, activeCounters, json);
+    benchHelp(schema, optionCount, minTime, json);
+    benchGetValue(schema, optionCount, minTime, json);
+    benchRegistration(optionCount, minTime, json);
+  }
+  for (const std::size_t flagCount : {10000U, 100000U}) {
+    if (flagCount > maxFlags->getValue()) {
+      continue;
+    }
+    benchFlagScale(flagCount, true, minTime, json);
+    benchFlagScale(flagCount, false, minTime, json);
+  }
+  return 0;
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -58,7 +58,20 @@ run_tests() {
                 if [ $? -eq 0 ]; then
                     echo ""
                     echo "Integer types tests passed!"
-                    return 0
+                    
+                    echo ""
+                    echo "Running generated options tests..."
+                    ./test_generated
+                    
+                    if [ $? -eq 0 ]; then
+                        echo ""
+                        echo "Generated options tests passed!"
+                        return 0
+                    else
+                        echo ""
+                        echo "Generated options tests failed!"
+                        return 1
+                    fi
                 else
                     echo ""
                     echo "Integer types tests failed!"
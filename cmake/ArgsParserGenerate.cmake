@@ -0,0 +1,23 @@
+# argsparser_generate(<target> <spec.json>)
+#
+# Generates <spec name>.hpp from a JSON option spec with the
+# argsparser_generate tool and makes it includable from <target>. The header
+# declares a struct with one typed field per option and a parse() that matches
+# names through generated switch statements; see README.md for the spec
+# format.
+function(argsparser_generate target spec)
+  get_filename_component(spec_path "${spec}" ABSOLUTE)
+  get_filename_component(spec_name "${spec}" NAME_WE)
+  set(output_dir "${CMAKE_CURRENT_BINARY_DIR}/argsparser_generated")
+  set(output "${output_dir}/${spec_name}.hpp")
+  add_custom_command(
+    OUTPUT "${output}"
+    COMMAND "${CMAKE_COMMAND}" -E make_directory "${output_dir}"
+    COMMAND argsparser_generate "${spec_path}" "${output}"
+    DEPENDS "${spec_path}" argsparser_generate
+    COMMENT "Generating ${spec_name}.hpp from ${spec}"
+    VERBATIM)
+  target_sources(${target} PRIVATE "${output}")
+  target_include_directories(${target} PRIVATE "${output_dir}")
+  target_link_libraries(${target} PRIVATE argsparser)
+endfunction()
@@ -37,6 +37,9 @@ auto main(int argc, char* argv[]) -> int {
   rate->setValidator([](float value) { return value > 0.0F; });
   precision->setValidator([](double value) { return value > 0.0; });
 
+  // Answer shell completion queries from the generated scripts
+  parser.enableCompletion();
+
   // Parse command line arguments
   auto result = parser.parse(argc, argv);
 
@@ -46,6 +49,10 @@ auto main(int argc, char* argv[]) -> int {
       parser.printHelp();
       return 0;
 
+    case argsparser::ParseResult::COMPLETION_REQUESTED:
+      parser.printCompletions();
+      return 0;
+
     case argsparser::ParseResult::SUCCESS:
       break;
 
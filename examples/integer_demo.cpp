@@ -16,8 +16,9 @@ int main(int argc, char* argv[]) {
   auto* unsigned_long = parser.addArgument<uint64_t>(
       "ulong", "g", "Unsigned long integer", false, 0UL);
 
-  // Set validators to show range capabilities
-  unsigned_int->setValidator([](uint32_t value) { return value > 0; });
+  // Set validators to show range capabilities; constraint objects are listed
+  // in the help output automatically
+  unsigned_int->setValidator(argsparser::inRange(1U, UINT32_MAX));
   long_int->setValidator([](int64_t value) { return value != 0; });
 
   auto result = parser.parse(argc, argv);
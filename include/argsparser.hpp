@@ -1,1658 +1,8025 @@
 #ifndef ARGSPARSER_HPP
 #define ARGSPARSER_HPP
 
+#include <algorithm>  // For std::sort
 #include <array>
+#include <atomic>  // For published snapshots and the counters
 #include <cerrno>   // For errno
+#include <cstddef>  // For std::size_t, std::max_align_t
 #include <cstdint>  // For fixed-width integer types
 #include <cstdio>   // For snprintf
 #include <cstdlib>  // For atoi
+#include <cstring>  // For strchr
 #include <functional>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>  // For std::next
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>  // For serializing ReloadableConfig reloads
+#include <new>    // For placement new
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>     // For open
+#include <sys/mman.h>  // For mmap
+#include <sys/stat.h>  // For fstat
+#include <unistd.h>    // For close
+#define ARGSPARSER_HAS_MMAP 1
+#else
+#define ARGSPARSER_HAS_MMAP 0
+#endif
+
+#if defined(__linux__)
+#include <poll.h>         // For poll
+#include <sys/inotify.h>  // For inotify_init1
+#define ARGSPARSER_HAS_INOTIFY 1
+#else
+#define ARGSPARSER_HAS_INOTIFY 0
+#endif
+
+#if defined(ARGSPARSER_STATISTICS)
+#include <chrono>  // For phase and latency timing
+#endif
+
+#if defined(_WIN32)
+#define ARGSPARSER_ENVIRON _environ
+#else
+extern "C" char** environ;  // NOLINT(readability-redundant-declaration)
+#define ARGSPARSER_ENVIRON environ
+#endif
+
 namespace argsparser {
 
 /**
- * @brief Error codes for argument parsing results
+ * @brief Error codes for argument parsing results
+ */
+enum class ParseResult : std::uint8_t {
+  SUCCESS = 0,     ///< Parsing completed successfully
+  UNKNOWN_OPTION,  ///< An unknown option was provided
+  MISSING_VALUE,   ///< A required value is missing
+  INVALID_VALUE,   ///< A value is invalid (wrong type or failed validation)
+  HELP_REQUESTED,  ///< Help was requested (-h or --help)
+  COMPLETION_REQUESTED  ///< Shell completion was requested (--__complete)
+};
+
+/**
+ * @brief Where an argument's current value came from
+ *
+ * Sources are ordered by precedence: a value from a higher source is never
+ * overwritten by a value from a lower one.
+ */
+enum class ValueSource : std::uint8_t {
+  DEFAULT = 0,  ///< The registered default value
+  CONFIG_FILE,  ///< A key=value / INI config file
+  ENVIRONMENT,  ///< A bound environment variable
+  COMMAND_LINE  ///< argv
+};
+
+/**
+ * @brief Whether registered names and descriptions are copied or referenced
+ */
+enum class StringStorage : std::uint8_t {
+  COPY = 0,  ///< Keep owned copies (one allocation per argument)
+  REFERENCE  ///< Point at caller storage that outlives the parser (literals)
+};
+
+/**
+ * @brief Constraint that parse() checks on a group of options
+ */
+enum class GroupKind : std::uint8_t {
+  MUTUALLY_EXCLUSIVE = 0,  ///< At most one of the options may be given
+  AT_LEAST_ONE,            ///< At least one of the options must be given
+  ALL_OR_NONE              ///< Either all of the options are given or none
+};
+
+/**
+ * @brief Location and description of a config file error
+ */
+struct ConfigError {
+  std::size_t line{0};    ///< 1-based line number (0 if not line related)
+  std::size_t column{0};  ///< 1-based column number (0 if not line related)
+  std::string message;    ///< Human-readable description of the problem
+};
+
+/**
+ * @brief Library phase that heap allocations are attributed to
+ */
+enum class AllocationPhase : std::uint8_t {
+  OTHER = 0,     ///< Outside of any accounted argsparser call
+  REGISTRATION,  ///< addArgument(), setSubcommands() and friends
+  PARSE,         ///< parse(), parseConfig() and parseConfigFile()
+  HELP,          ///< printHelp()
+  COUNT          ///< Number of phases (not a phase itself)
+};
+
+/**
+ * @brief Heap allocations counted for one phase
+ */
+struct AllocationCounters {
+  std::uint64_t allocations{0};  ///< Number of operator new calls
+  std::uint64_t bytes{0};        ///< Total bytes requested
+};
+
+#if defined(ARGSPARSER_ALLOCATION_ACCOUNTING)
+
+namespace detail {
+
+/**
+ * @brief Per-thread accounting state
+ *
+ * Constant-initialized, so touching it from operator new never allocates.
+ */
+struct AllocationState {
+  AllocationPhase phase{AllocationPhase::OTHER};
+  std::array<AllocationCounters,
+             static_cast<std::size_t>(AllocationPhase::COUNT)>
+      counters{};
+};
+
+inline AllocationState& allocationState() {
+  thread_local AllocationState state;
+  return state;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Attribute one allocation to the current thread's active phase
+ *
+ * Called by the operator new replacements installed by defining
+ * ARGSPARSER_DEFINE_ALLOCATION_HOOKS; custom allocator hooks may call it too.
+ * @param bytes The number of bytes requested
+ */
+inline void recordAllocation(std::size_t bytes) {
+  detail::AllocationState& state = detail::allocationState();
+  AllocationCounters& counters =
+      state.counters[static_cast<std::size_t>(state.phase)];
+  ++counters.allocations;
+  counters.bytes += bytes;
+}
+
+/**
+ * @brief Get the allocations counted on this thread for a phase
+ * @param phase The phase to query
+ * @return AllocationCounters The counters since the last reset
+ */
+inline AllocationCounters getAllocationCounters(AllocationPhase phase) {
+  return detail::allocationState()
+      .counters[static_cast<std::size_t>(phase)];
+}
+
+/**
+ * @brief Reset this thread's allocation counters for every phase
+ */
+inline void resetAllocationCounters() {
+  detail::allocationState().counters = {};
+}
+
+/**
+ * @brief Attributes allocations to a phase for the lifetime of the scope
+ *
+ * Scopes nest; the innermost one wins, so a subcommand factory running inside
+ * parse() is still counted as registration.
+ */
+class AllocationPhaseScope {
+ private:
+  AllocationPhase previous_;
+
+ public:
+  explicit AllocationPhaseScope(AllocationPhase phase)
+      : previous_(detail::allocationState().phase) {
+    detail::allocationState().phase = phase;
+  }
+
+  AllocationPhaseScope(const AllocationPhaseScope&) = delete;
+  AllocationPhaseScope& operator=(const AllocationPhaseScope&) = delete;
+  AllocationPhaseScope(AllocationPhaseScope&&) = delete;
+  AllocationPhaseScope& operator=(AllocationPhaseScope&&) = delete;
+
+  ~AllocationPhaseScope() { detail::allocationState().phase = previous_; }
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define ARGSPARSER_ALLOCATION_PHASE(phase)                  \
+  const ::argsparser::AllocationPhaseScope allocationPhase_( \
+      ::argsparser::AllocationPhase::phase)
+
+#else
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define ARGSPARSER_ALLOCATION_PHASE(phase) static_cast<void>(0)
+
+#endif  // ARGSPARSER_ALLOCATION_ACCOUNTING
+
+/**
+ * @brief Step of Parser::parse() reported to a trace handler
+ */
+enum class TracePhase : std::uint8_t {
+  TOKENIZE = 0,    ///< Splitting an argv token into name and value
+  LOOKUP,          ///< Resolving an option name to its argument
+  CONVERT,         ///< Converting a value to the argument's type
+  VALIDATE,        ///< Running the argument's validator or constraint
+  REQUIRED_CHECK,  ///< Checking that required arguments received values
+  COUNT            ///< Number of phases (not a phase itself)
+};
+
+/**
+ * @brief One begin or end event delivered to a trace handler
+ */
+struct TraceEvent {
+  TracePhase phase;       ///< The step that begins or ends
+  bool begin;             ///< true at the start of the step, false at its end
+  int argvIndex;          ///< Index of the argv token, or -1 if none
+  std::string_view name;  ///< The token or argument name, possibly empty
+};
+
+/**
+ * @brief Receives trace events; called synchronously on the parsing thread
+ */
+using TraceHandler = void (*)(const TraceEvent& event, void* context);
+
+#if defined(ARGSPARSER_TRACING)
+
+namespace detail {
+
+/**
+ * @brief Per-thread tracing state
+ */
+struct TraceState {
+  TraceHandler handler{nullptr};
+  void* context{nullptr};
+  int argvIndex{-1};  ///< Index of the innermost traced token
+};
+
+inline TraceState& traceState() {
+  thread_local TraceState state;
+  return state;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Install the trace handler for parsers running on this thread
+ * @param handler The handler, or nullptr to stop tracing
+ * @param context Passed unchanged to every handler call
+ */
+inline void setTraceHandler(TraceHandler handler, void* context = nullptr) {
+  detail::traceState().handler = handler;
+  detail::traceState().context = context;
+}
+
+/**
+ * @brief Reports the begin and end of a parse step to the trace handler
+ */
+class TraceScope {
+ private:
+  TraceEvent event_;
+  int previousIndex_;
+
+ public:
+  TraceScope(TracePhase phase, int argvIndex, std::string_view name)
+      : event_{phase, true, argvIndex, name},
+        previousIndex_(detail::traceState().argvIndex) {
+    detail::TraceState& state = detail::traceState();
+    state.argvIndex = argvIndex;
+    if (state.handler != nullptr) {
+      state.handler(event_, state.context);
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+  TraceScope(TraceScope&&) = delete;
+  TraceScope& operator=(TraceScope&&) = delete;
+
+  ~TraceScope() {
+    detail::TraceState& state = detail::traceState();
+    event_.begin = false;
+    if (state.handler != nullptr) {
+      state.handler(event_, state.context);
+    }
+    state.argvIndex = previousIndex_;
+  }
+};
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define ARGSPARSER_TRACE_CONCAT_(a, b) a##b
+#define ARGSPARSER_TRACE_CONCAT(a, b) ARGSPARSER_TRACE_CONCAT_(a, b)
+#define ARGSPARSER_TRACE_SCOPE(phase, argvIndex, name)         \
+  const ::argsparser::TraceScope ARGSPARSER_TRACE_CONCAT(      \
+      traceScope_, __LINE__)(::argsparser::TracePhase::phase, \
+                             (argvIndex), (name))
+// Index of the token being traced, for steps that do not know it themselves
+#define ARGSPARSER_TRACE_INDEX() (::argsparser::detail::traceState().argvIndex)
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+#else
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define ARGSPARSER_TRACE_SCOPE(phase, argvIndex, name) static_cast<void>(0)
+
+#endif  // ARGSPARSER_TRACING
+
+/**
+ * @brief Snapshot of a parser's runtime statistics
+ *
+ * Phase times are inclusive: the conversion time of an argument includes its
+ * validator.
+ */
+struct ParseStatistics {
+  /// Number of latency histogram buckets
+  static constexpr std::size_t kLatencyBuckets = 16;
+  /// Number of parse phases with a cumulative time
+  static constexpr std::size_t kPhases =
+      static_cast<std::size_t>(TracePhase::COUNT);
+
+  std::uint64_t parseCalls{0};      ///< Calls to parse()
+  std::uint64_t tokens{0};          ///< argv tokens processed
+  std::uint64_t lookups{0};         ///< Option name lookups
+  std::uint64_t lookupMisses{0};    ///< Lookups that found no option
+  std::uint64_t conversions{0};     ///< Values converted to argument types
+  std::uint64_t validatorCalls{0};  ///< Validators and constraints run
+  /// Cumulative nanoseconds per phase, indexed by TracePhase
+  std::array<std::uint64_t, kPhases> phaseNanoseconds{};
+  /// parse() calls by latency: bucket 0 counts calls under 1 us, bucket b
+  /// calls under 2^b us, and the last bucket everything slower
+  std::array<std::uint64_t, kLatencyBuckets> latencyBuckets{};
+};
+
+#if defined(ARGSPARSER_STATISTICS)
+
+namespace detail {
+
+/**
+ * @brief Live statistics counters, safe to read while another thread parses
+ */
+struct StatisticsCounters {
+  using Counter = std::atomic<std::uint64_t>;
+
+  Counter parseCalls{0};
+  Counter tokens{0};
+  Counter lookupMisses{0};
+  std::array<Counter, ParseStatistics::kPhases> phaseCalls{};
+  std::array<Counter, ParseStatistics::kPhases> phaseNanoseconds{};
+  std::array<Counter, ParseStatistics::kLatencyBuckets> latencyBuckets{};
+
+  StatisticsCounters() = default;
+  ~StatisticsCounters() = default;
+  StatisticsCounters(const StatisticsCounters&) = delete;
+  StatisticsCounters& operator=(const StatisticsCounters&) = delete;
+
+  // Moving keeps Parser movable; the counters are carried over
+  StatisticsCounters(StatisticsCounters&& other) noexcept {
+    *this = std::move(other);
+  }
+
+  StatisticsCounters& operator=(StatisticsCounters&& other) noexcept {
+    parseCalls = load(other.parseCalls);
+    tokens = load(other.tokens);
+    lookupMisses = load(other.lookupMisses);
+    for (std::size_t i = 0; i < ParseStatistics::kPhases; ++i) {
+      phaseCalls[i] = load(other.phaseCalls[i]);
+      phaseNanoseconds[i] = load(other.phaseNanoseconds[i]);
+    }
+    for (std::size_t i = 0; i < ParseStatistics::kLatencyBuckets; ++i) {
+      latencyBuckets[i] = load(other.latencyBuckets[i]);
+    }
+    return *this;
+  }
+
+  static void add(Counter& counter, std::uint64_t amount = 1) {
+    counter.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  static std::uint64_t load(const Counter& counter) {
+    return counter.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] ParseStatistics snapshot() const {
+    ParseStatistics out;
+    out.parseCalls = load(parseCalls);
+    out.tokens = load(tokens);
+    out.lookups =
+        load(phaseCalls[static_cast<std::size_t>(TracePhase::LOOKUP)]);
+    out.lookupMisses = load(lookupMisses);
+    out.conversions =
+        load(phaseCalls[static_cast<std::size_t>(TracePhase::CONVERT)]);
+    out.validatorCalls =
+        load(phaseCalls[static_cast<std::size_t>(TracePhase::VALIDATE)]);
+    for (std::size_t i = 0; i < ParseStatistics::kPhases; ++i) {
+      out.phaseNanoseconds[i] = load(phaseNanoseconds[i]);
+    }
+    for (std::size_t i = 0; i < ParseStatistics::kLatencyBuckets; ++i) {
+      out.latencyBuckets[i] = load(latencyBuckets[i]);
+    }
+    return out;
+  }
+
+  void reset() {
+    parseCalls = 0;
+    tokens = 0;
+    lookupMisses = 0;
+    for (auto& counter : phaseCalls) {
+      counter = 0;
+    }
+    for (auto& counter : phaseNanoseconds) {
+      counter = 0;
+    }
+    for (auto& counter : latencyBuckets) {
+      counter = 0;
+    }
+  }
+};
+
+/**
+ * @brief The counters of the parse() running on this thread, if any
+ */
+inline StatisticsCounters*& currentStatistics() {
+  thread_local StatisticsCounters* current = nullptr;
+  return current;
+}
+
+/**
+ * @brief Makes a parser's counters current and times the whole parse()
+ */
+class ParseStatisticsScope {
+ private:
+  StatisticsCounters* previous_;
+  StatisticsCounters& counters_;
+  std::chrono::steady_clock::time_point start_;
+
+ public:
+  explicit ParseStatisticsScope(StatisticsCounters& counters)
+      : previous_(currentStatistics()),
+        counters_(counters),
+        start_(std::chrono::steady_clock::now()) {
+    currentStatistics() = &counters;
+    StatisticsCounters::add(counters.parseCalls);
+  }
+
+  ParseStatisticsScope(const ParseStatisticsScope&) = delete;
+  ParseStatisticsScope& operator=(const ParseStatisticsScope&) = delete;
+  ParseStatisticsScope(ParseStatisticsScope&&) = delete;
+  ParseStatisticsScope& operator=(ParseStatisticsScope&&) = delete;
+
+  ~ParseStatisticsScope() {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start_)
+                             .count();
+    std::size_t bucket = 0;
+    while (bucket + 1 < ParseStatistics::kLatencyBuckets &&
+           elapsed >= (std::int64_t{1} << bucket)) {
+      ++bucket;
+    }
+    StatisticsCounters::add(counters_.latencyBuckets[bucket]);
+    currentStatistics() = previous_;
+  }
+};
+
+/**
+ * @brief Counts and times one parse phase for the current parser
+ */
+class PhaseStatisticsScope {
+ private:
+  StatisticsCounters* counters_;
+  std::size_t phase_;
+  std::chrono::steady_clock::time_point start_;
+
+ public:
+  explicit PhaseStatisticsScope(TracePhase phase)
+      : counters_(currentStatistics()),
+        phase_(static_cast<std::size_t>(phase)),
+        start_(std::chrono::steady_clock::now()) {}
+
+  PhaseStatisticsScope(const PhaseStatisticsScope&) = delete;
+  PhaseStatisticsScope& operator=(const PhaseStatisticsScope&) = delete;
+  PhaseStatisticsScope(PhaseStatisticsScope&&) = delete;
+  PhaseStatisticsScope& operator=(PhaseStatisticsScope&&) = delete;
+
+  ~PhaseStatisticsScope() {
+    if (counters_ == nullptr) {
+      return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_);
+    StatisticsCounters::add(counters_->phaseCalls[phase_]);
+    StatisticsCounters::add(counters_->phaseNanoseconds[phase_],
+                            static_cast<std::uint64_t>(elapsed.count()));
+  }
+};
+
+}  // namespace detail
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define ARGSPARSER_STATISTICS_CONCAT_(a, b) a##b
+#define ARGSPARSER_STATISTICS_CONCAT(a, b) ARGSPARSER_STATISTICS_CONCAT_(a, b)
+#define ARGSPARSER_STATISTICS_SCOPE(phase)                    \
+  const ::argsparser::detail::PhaseStatisticsScope            \
+  ARGSPARSER_STATISTICS_CONCAT(statisticsScope_, __LINE__)(   \
+      ::argsparser::TracePhase::phase)
+#define ARGSPARSER_STATISTICS_COUNT(counter)                              \
+  do {                                                                    \
+    if (::argsparser::detail::currentStatistics() != nullptr) {          \
+      ::argsparser::detail::StatisticsCounters::add(                      \
+          ::argsparser::detail::currentStatistics()->counter);            \
+    }                                                                     \
+  } while (false)
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+#else
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define ARGSPARSER_STATISTICS_SCOPE(phase) static_cast<void>(0)
+#define ARGSPARSER_STATISTICS_COUNT(counter) static_cast<void>(0)
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+#endif  // ARGSPARSER_STATISTICS
+
+// Marks one step of parse() for tracing and statistics
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define ARGSPARSER_PARSE_STEP(phase, argvIndex, name) \
+  ARGSPARSER_TRACE_SCOPE(phase, argvIndex, name);     \
+  ARGSPARSER_STATISTICS_SCOPE(phase)
+
+namespace detail {
+
+/**
+ * @brief Detect whether a callable can describe itself for help output
+ */
+template <typename C, typename = void>
+struct IsDescribable : std::false_type {};
+
+template <typename C>
+struct IsDescribable<C, std::void_t<decltype(std::declval<const C&>().describe(
+                            std::declval<std::string&>()))>>
+    : std::true_type {};
+
+/**
+ * @brief Detect whether a callable can list completion candidates
+ */
+template <typename C, typename = void>
+struct IsCompletable : std::false_type {};
+
+template <typename C>
+struct IsCompletable<C, std::void_t<decltype(std::declval<const C&>().complete(
+                            std::declval<std::string_view>(),
+                            std::declval<std::ostream&>()))>>
+    : std::true_type {};
+
+/**
+ * @brief Compare two values with "less than", safe for mixed signedness
+ *
+ * Integral operands of different signedness are compared by value rather than
+ * after the usual arithmetic conversions, so inRange(-1, 10) behaves as
+ * expected on an unsigned argument.
+ */
+template <typename A, typename B>
+constexpr bool lessThan(const A& lhs, const B& rhs) {
+  if constexpr (std::is_integral_v<A> && std::is_integral_v<B> &&
+                std::is_signed_v<A> != std::is_signed_v<B>) {
+    if constexpr (std::is_signed_v<A>) {
+      return lhs < 0 || static_cast<std::make_unsigned_t<A>>(lhs) < rhs;
+    } else {
+      return rhs >= 0 && lhs < static_cast<std::make_unsigned_t<B>>(rhs);
+    }
+  } else {
+    return lhs < rhs;
+  }
+}
+
+/**
+ * @brief Compare two values for equality, safe for mixed signedness
+ */
+template <typename A, typename B>
+constexpr bool equalTo(const A& lhs, const B& rhs) {
+  if constexpr (std::is_integral_v<A> && std::is_integral_v<B>) {
+    return !lessThan(lhs, rhs) && !lessThan(rhs, lhs);
+  } else {
+    return lhs == rhs;
+  }
+}
+
+/**
+ * @brief Append a constraint bound or choice to a help string
+ */
+inline void appendValue(std::string& out, const std::string& value) {
+  out += value;
+}
+
+inline void appendValue(std::string& out, const char* value) { out += value; }
+
+template <typename V>
+std::enable_if_t<std::is_integral_v<V>> appendValue(std::string& out,
+                                                    V value) {
+  out += std::to_string(value);
+}
+
+template <typename V>
+std::enable_if_t<std::is_floating_point_v<V>> appendValue(std::string& out,
+                                                          V value) {
+  constexpr std::size_t size = 32;
+  std::array<char, size> buffer{};
+  const int len = std::snprintf(buffer.data(), buffer.size(), "%g",
+                                static_cast<double>(value));
+  if (len > 0 && static_cast<std::size_t>(len) < buffer.size()) {
+    out.append(buffer.data(), static_cast<std::size_t>(len));
+  }
+}
+
+/**
+ * @brief Null-terminated copy of a string_view for the C conversion functions
+ *
+ * strtol() and friends need a terminated string, while values arrive as views
+ * into argv, the environment or a mapped config file. Short values (every
+ * realistic number) are copied into an inline buffer; only longer ones fall
+ * back to a heap-allocated string.
+ */
+class TerminatedCopy {
+ private:
+  static constexpr std::size_t kInlineSize = 64;
+  std::array<char, kInlineSize> inline_{};
+  std::string heap_;
+  const char* text_;
+
+ public:
+  /**
+   * @brief Copy a view into terminated storage
+   * @param value The view to copy
+   */
+  explicit TerminatedCopy(std::string_view value) : text_(inline_.data()) {
+    if (value.size() < kInlineSize) {
+      std::memcpy(inline_.data(), value.data(), value.size());
+      inline_[value.size()] = '\0';
+    } else {
+      heap_.assign(value.data(), value.size());
+      text_ = heap_.c_str();
+    }
+  }
+
+  TerminatedCopy(const TerminatedCopy&) = delete;
+  TerminatedCopy& operator=(const TerminatedCopy&) = delete;
+  TerminatedCopy(TerminatedCopy&&) = delete;
+  TerminatedCopy& operator=(TerminatedCopy&&) = delete;
+  ~TerminatedCopy() = default;
+
+  /**
+   * @brief Get the terminated copy
+   * @return Pointer to the null-terminated characters
+   */
+  [[nodiscard]] const char* c_str() const { return text_; }
+};
+
+/**
+ * @brief Convert text to a signed integer, rejecting trailing text and
+ * out-of-range values
+ */
+template <typename T>
+bool convertSigned(std::string_view value, T& out) {
+  const TerminatedCopy text(value);
+  char* end = nullptr;
+  errno = 0;  // Reset errno before calling strtoll
+  constexpr auto radix = 10;
+  const long long parsedValue = std::strtoll(text.c_str(), &end, radix);
+  if (*end != '\0' || errno == ERANGE ||
+      parsedValue > std::numeric_limits<T>::max() ||
+      parsedValue < std::numeric_limits<T>::min()) {
+    return false;
+  }
+  out = static_cast<T>(parsedValue);
+  return true;
+}
+
+/**
+ * @brief Convert text to an unsigned integer, rejecting trailing text,
+ * out-of-range and negative values
+ */
+template <typename T>
+bool convertUnsigned(std::string_view value, T& out) {
+  const TerminatedCopy text(value);
+  char* end = nullptr;
+  errno = 0;  // Reset errno before calling strtoull
+  constexpr auto radix = 10;
+  const unsigned long long parsedValue =
+      std::strtoull(text.c_str(), &end, radix);
+  // strtoull wraps negative values, so check the sign in the original text
+  if (*end != '\0' || errno == ERANGE ||
+      parsedValue > std::numeric_limits<T>::max() ||
+      (!value.empty() && value[0] == '-')) {
+    return false;
+  }
+  out = static_cast<T>(parsedValue);
+  return true;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Convert command-line text to a value, as Argument<T>::parse() does
+ *
+ * The whole text must convert and fit the type; validators are not applied.
+ * These overloads are also used by code from the argsparser_generate tool.
+ * @param value The text
+ * @param out Receives the value; unchanged on failure
+ * @return true if the text converted, false otherwise
+ */
+inline bool convertValue(std::string_view value, int16_t& out) {
+  return detail::convertSigned(value, out);
+}
+
+/// @copydoc convertValue(std::string_view, int16_t&)
+inline bool convertValue(std::string_view value, int32_t& out) {
+  return detail::convertSigned(value, out);
+}
+
+/// @copydoc convertValue(std::string_view, int16_t&)
+inline bool convertValue(std::string_view value, int64_t& out) {
+  return detail::convertSigned(value, out);
+}
+
+/// @copydoc convertValue(std::string_view, int16_t&)
+inline bool convertValue(std::string_view value, uint32_t& out) {
+  return detail::convertUnsigned(value, out);
+}
+
+/// @copydoc convertValue(std::string_view, int16_t&)
+inline bool convertValue(std::string_view value, uint64_t& out) {
+  return detail::convertUnsigned(value, out);
+}
+
+/// @copydoc convertValue(std::string_view, int16_t&)
+inline bool convertValue(std::string_view value, float& out) {
+  const detail::TerminatedCopy text(value);
+  char* end = nullptr;
+  errno = 0;  // Reset errno before calling strtof
+  const float parsedValue = std::strtof(text.c_str(), &end);
+  // strtof sets errno to ERANGE on overflow and underflow
+  if (*end != '\0' || errno == ERANGE) {
+    return false;
+  }
+  out = parsedValue;
+  return true;
+}
+
+/// @copydoc convertValue(std::string_view, int16_t&)
+inline bool convertValue(std::string_view value, double& out) {
+  const detail::TerminatedCopy text(value);
+  char* end = nullptr;
+  errno = 0;  // Reset errno before calling strtod
+  const double parsedValue = std::strtod(text.c_str(), &end);
+  // strtod sets errno to ERANGE on overflow and underflow
+  if (*end != '\0' || errno == ERANGE) {
+    return false;
+  }
+  out = parsedValue;
+  return true;
+}
+
+/**
+ * @brief Convert a boolean value
+ * @param value "true", "1", "yes", "on" or empty for true; "false", "0",
+ * "no" or "off" for false
+ * @param out Receives the value; unchanged on failure
+ * @return true if the value was recognized, false otherwise
+ */
+inline bool convertValue(std::string_view value, bool& out) {
+  if (value.empty() || value == "true" || value == "1" || value == "yes" ||
+      value == "on") {
+    out = true;
+  } else if (value == "false" || value == "0" || value == "no" ||
+             value == "off") {
+    out = false;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Copy a string value (always succeeds)
+ * @param value The text
+ * @param out Receives the text
+ * @return true
+ */
+inline bool convertValue(std::string_view value, std::string& out) {
+  out.assign(value.data(), value.size());
+  return true;
+}
+
+namespace detail {
+
+/**
+ * @brief Read-only view of a whole file, memory-mapped where available
+ *
+ * On POSIX systems the file is mapped with mmap() so it can be tokenized in
+ * place; elsewhere it is read into a single buffer.
+ */
+class MappedFile {
+ private:
+  const char* data_{nullptr};
+  std::size_t size_{0};
+  bool open_{false};
+#if ARGSPARSER_HAS_MMAP
+  void* mapping_{nullptr};
+#else
+  std::vector<char> buffer_;
+#endif
+
+ public:
+  /**
+   * @brief Map (or read) a file
+   * @param path The path of the file
+   */
+  explicit MappedFile(const char* path) {
+#if ARGSPARSER_HAS_MMAP
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) == 0 && info.st_size >= 0) {
+      size_ = static_cast<std::size_t>(info.st_size);
+      if (size_ == 0) {
+        open_ = true;
+      } else {
+        void* mapping =
+            ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+        if (mapping != MAP_FAILED) {
+          mapping_ = mapping;
+          data_ = static_cast<const char*>(mapping);
+          open_ = true;
+        }
+      }
+    }
+    ::close(fd);
+#else
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) {
+      return;
+    }
+    constexpr std::size_t chunk = 4096;
+    std::size_t used = 0;
+    for (;;) {
+      buffer_.resize(used + chunk);
+      const std::size_t got = std::fread(buffer_.data() + used, 1, chunk, file);
+      used += got;
+      if (got < chunk) {
+        break;
+      }
+    }
+    open_ = std::ferror(file) == 0;
+    std::fclose(file);
+    buffer_.resize(used);
+    data_ = buffer_.data();
+    size_ = used;
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  /**
+   * @brief Unmap the file
+   */
+  ~MappedFile() {
+#if ARGSPARSER_HAS_MMAP
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, size_);
+    }
+#endif
+  }
+
+  /**
+   * @brief Check whether the file could be opened
+   * @return true if the contents are available, false otherwise
+   */
+  [[nodiscard]] bool isOpen() const { return open_; }
+
+  /**
+   * @brief Get the file contents
+   * @return A view of the whole file
+   */
+  [[nodiscard]] std::string_view contents() const { return {data_, size_}; }
+};
+
+/**
+ * @brief Check whether a character is horizontal whitespace
+ */
+constexpr bool isBlank(char c) { return c == ' ' || c == '\t'; }
+
+/**
+ * @brief Remove leading and trailing horizontal whitespace from a view
+ */
+constexpr std::string_view trimBlanks(std::string_view text) {
+  while (!text.empty() && isBlank(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && isBlank(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+/**
+ * @brief Damerau-Levenshtein distance (optimal string alignment variant)
+ *
+ * Counts insertions, deletions, substitutions and transpositions of adjacent
+ * characters. The computation stops early once every alignment exceeds the
+ * limit. Without transpositions this is the Levenshtein distance, which
+ * (unlike the optimal string alignment) satisfies the triangle inequality.
+ * @param lhs The first string
+ * @param rhs The second string
+ * @param limit The largest distance of interest
+ * @param rows Scratch rows, grown as needed and reused across calls
+ * @param transpositions Whether an adjacent transposition is a single edit
+ * @return The distance, or limit + 1 if it exceeds the limit
+ */
+inline std::size_t editDistance(std::string_view lhs, std::string_view rhs,
+                                std::size_t limit,
+                                std::vector<std::size_t>& rows,
+                                bool transpositions = true) {
+  const std::size_t lengthGap = lhs.size() > rhs.size()
+                                    ? lhs.size() - rhs.size()
+                                    : rhs.size() - lhs.size();
+  if (lengthGap > limit) {
+    return limit + 1;
+  }
+
+  // Three rolling rows: i - 2, i - 1 and i
+  if (rows.size() < 3 * (rhs.size() + 1)) {
+    rows.resize(3 * (rhs.size() + 1));
+  }
+  std::size_t* beforePrevious = rows.data();
+  std::size_t* previous = beforePrevious + rhs.size() + 1;
+  std::size_t* current = previous + rhs.size() + 1;
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  for (std::size_t j = 0; j <= rhs.size(); ++j) {
+    previous[j] = j;
+  }
+  for (std::size_t i = 1; i <= lhs.size(); ++i) {
+    current[0] = i;
+    std::size_t rowMinimum = current[0];
+    for (std::size_t j = 1; j <= rhs.size(); ++j) {
+      const std::size_t cost = lhs[i - 1] == rhs[j - 1] ? 0 : 1;
+      std::size_t best = std::min({previous[j] + 1, current[j - 1] + 1,
+                                   previous[j - 1] + cost});
+      if (transpositions && i > 1 && j > 1 && lhs[i - 1] == rhs[j - 2] &&
+          lhs[i - 2] == rhs[j - 1]) {
+        best = std::min(best, beforePrevious[j - 2] + 1);
+      }
+      current[j] = best;
+      rowMinimum = std::min(rowMinimum, best);
+    }
+    if (rowMinimum > limit) {
+      return limit + 1;
+    }
+    std::swap(beforePrevious, previous);
+    std::swap(previous, current);
+  }
+  const std::size_t distance = previous[rhs.size()];
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  return distance > limit ? limit + 1 : distance;
+}
+
+/**
+ * @brief Damerau-Levenshtein distance (optimal string alignment variant)
+ *
+ * @param lhs The first string
+ * @param rhs The second string
+ * @param limit The largest distance of interest
+ * @return The distance, or limit + 1 if it exceeds the limit
+ */
+inline std::size_t editDistance(std::string_view lhs, std::string_view rhs,
+                                std::size_t limit) {
+  std::vector<std::size_t> rows;
+  return editDistance(lhs, rhs, limit, rows);
+}
+
+/**
+ * @brief Largest edit distance at which a name is still suggested
+ * @param name The unknown name typed by the user
+ * @return 1 for short names, 2 otherwise
+ */
+constexpr std::size_t suggestionTolerance(std::string_view name) {
+  constexpr std::size_t shortName = 4;
+  return name.size() <= shortName ? 1 : 2;
+}
+
+/**
+ * @brief A name and its position, sortable by name
+ *
+ * The first eight bytes are kept as a big-endian integer, so most
+ * comparisons are a single integer compare instead of a memcmp call.
+ */
+struct SortEntry {
+  std::uint64_t prefix{0};
+  std::string_view name;
+  std::size_t index{0};
+
+  SortEntry() = default;
+  SortEntry(std::string_view entryName, std::size_t entryIndex)
+      : name(entryName), index(entryIndex) {
+    constexpr std::size_t prefixBytes = sizeof(prefix);
+    for (std::size_t i = 0; i < prefixBytes; ++i) {
+      prefix <<= 8U;
+      if (i < name.size()) {
+        prefix |= static_cast<unsigned char>(name[i]);
+      }
+    }
+  }
+
+  friend bool operator<(const SortEntry& lhs, const SortEntry& rhs) {
+    return lhs.prefix != rhs.prefix ? lhs.prefix < rhs.prefix
+                                    : lhs.name < rhs.name;
+  }
+};
+
+/**
+ * @brief Growable bitset stored as 64-bit words
+ */
+class BitVector {
+ private:
+  std::vector<std::uint64_t> words_;
+  std::size_t size_{0};
+
+ public:
+  static constexpr std::size_t kWordBits = 64;
+
+  void reserve(std::size_t bits) {
+    words_.reserve((bits + kWordBits - 1) / kWordBits);
+  }
+
+  void pushBack(bool value) {
+    if (size_ % kWordBits == 0) {
+      words_.push_back(0);
+    }
+    ++size_;
+    if (value) {
+      set(size_ - 1);
+    }
+  }
+
+  [[nodiscard]] bool test(std::size_t bit) const {
+    return ((words_[bit / kWordBits] >> (bit % kWordBits)) & 1U) != 0;
+  }
+
+  void set(std::size_t bit) {
+    words_[bit / kWordBits] |= std::uint64_t{1} << (bit % kWordBits);
+  }
+
+  void reset(std::size_t bit) {
+    words_[bit / kWordBits] &= ~(std::uint64_t{1} << (bit % kWordBits));
+  }
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+
+  [[nodiscard]] const std::vector<std::uint64_t>& words() const {
+    return words_;
+  }
+};
+
+/**
+ * @brief Index of the lowest set bit of a non-zero word
+ */
+inline std::size_t lowestSetBit(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+  std::size_t bit = 0;
+  while ((word & 1U) == 0) {
+    word >>= 1U;
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+/**
+ * @brief Number of set bits in a word
+ */
+inline std::size_t popCount(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+  std::size_t count = 0;
+  for (; word != 0; word &= word - 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+/**
+ * @brief 64-bit FNV-1a hash of a byte string
+ */
+inline std::uint64_t fnv1a(std::string_view bytes) {
+  std::uint64_t value = 14695981039346656037ULL;
+  for (const char c : bytes) {
+    value = (value ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  return value;
+}
+
+/**
+ * @brief Heap bytes owned by a string (0 while it fits the inline buffer)
+ */
+inline std::size_t heapBytes(const std::string& text) {
+  const char* data = text.data();
+  const auto* object = reinterpret_cast<const char*>(&text);
+  const std::less<const char*> before;
+  const bool isInline =
+      !before(data, object) && before(data, object + sizeof(text));
+  return isInline ? 0 : text.capacity() + 1;
+}
+
+/**
+ * @brief Estimated size of one std::map node holding a Value
+ *
+ * Red-black tree nodes in libstdc++, libc++ and MSVC carry three links and a
+ * color in front of the value.
+ */
+template <typename Value>
+constexpr std::size_t mapNodeBytes() {
+  return 4 * sizeof(void*) + sizeof(Value);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Heap footprint of a parser's schema, broken down by category
+ *
+ * Values are the bytes requested from the allocator (allocator overhead is
+ * not included); map nodes are estimated from the usual node layout.
+ */
+struct MemoryUsage {
+  std::size_t argumentObjects{0};  ///< Argument objects, minus validators
+  std::size_t strings{0};  ///< Owned names, descriptions and string values
+  std::size_t mapNodes{0};    ///< Nodes of the name lookup maps
+  std::size_t validators{0};  ///< Validator storage, inline and on the heap
+  std::size_t positionalScratch{0};  ///< Positional argument slots
+  std::size_t indexes{0};  ///< Option table, name index, suggestion tree
+  std::size_t packedFlags{0};  ///< Packed flag names, bits and hash table
+
+  /**
+   * @brief Sum of all categories
+   * @return std::size_t The total number of bytes
+   */
+  [[nodiscard]] std::size_t total() const {
+    return argumentObjects + strings + mapNodes + validators +
+           positionalScratch + indexes + packedFlags;
+  }
+
+  /**
+   * @brief Add another report category by category
+   * @param other The report to add
+   * @return MemoryUsage& This report
+   */
+  MemoryUsage& operator+=(const MemoryUsage& other) {
+    argumentObjects += other.argumentObjects;
+    strings += other.strings;
+    mapNodes += other.mapNodes;
+    validators += other.validators;
+    positionalScratch += other.positionalScratch;
+    indexes += other.indexes;
+    packedFlags += other.packedFlags;
+    return *this;
+  }
+};
+
+/**
+ * @brief A parser's current values in flat arrays, for comparing parses in
+ * bulk
+ *
+ * Filled by Parser::packValues(). Entry i is the i-th option in
+ * registration order, followed by the positional arguments and then the
+ * packed flags. Views refer to the parser, which must stay unchanged.
+ */
+struct PackedValues {
+  std::vector<std::string_view> names;  ///< Long name of each entry
+  /// Value bits (the FNV-1a hash for strings, 0 for other types)
+  std::vector<std::uint64_t> slots;
+  std::vector<std::string_view> text;  ///< String values; empty otherwise
+  detail::BitVector set;               ///< Entries that received a value
+};
+
+/**
+ * @brief Number of bytes available for a validator stored by InlineValidator
+ *
+ * Large enough for a std::function (so the std::function based setValidator
+ * overloads keep working) and for lambdas capturing a few pointers or scalars.
+ */
+constexpr std::size_t kInlineValidatorCapacity =
+    sizeof(std::function<bool()>) > 4 * sizeof(void*)
+        ? sizeof(std::function<bool()>)
+        : 4 * sizeof(void*);
+
+/**
+ * @brief Small-buffer, allocation-free storage for a validator callable
+ *
+ * The callable is stored by value inside the object and invoked through a
+ * per-type thunk, so capturing lambdas never touch the heap and the call site
+ * is a direct call into code where the lambda body is inlined. Callables that
+ * do not fit into kInlineValidatorCapacity (or are over-aligned) are moved
+ * to the heap instead, and the buffer holds a pointer to them.
+ * @tparam T The value type the validator inspects
+ */
+template <typename T>
+class InlineValidator {
+ private:
+  using InvokeFn = bool (*)(const void*, const T&);
+  using DestroyFn = void (*)(void*);
+  using DescribeFn = void (*)(const void*, std::string&);
+  using CompleteFn = void (*)(const void*, std::string_view, std::ostream&);
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineValidatorCapacity]{};
+  InvokeFn invoke_{nullptr};
+  DestroyFn destroy_{nullptr};
+  DescribeFn describe_{nullptr};
+  CompleteFn complete_{nullptr};
+  std::size_t heapBytes_{0};
+
+  /// Whether a callable type is stored in the buffer rather than the heap
+  template <typename Callable>
+  static constexpr bool kStoredInline =
+      sizeof(Callable) <= kInlineValidatorCapacity &&
+      alignof(Callable) <= alignof(std::max_align_t);
+
+  /// The stored callable, in the buffer or behind the buffered pointer
+  template <typename Callable>
+  static const Callable& stored(const void* object) {
+    if constexpr (kStoredInline<Callable>) {
+      return *static_cast<const Callable*>(object);
+    } else {
+      return **static_cast<const Callable* const*>(object);
+    }
+  }
+
+ public:
+  InlineValidator() = default;
+
+  /**
+   * @brief Destroy the stored callable, if any
+   */
+  ~InlineValidator() { reset(); }
+
+  InlineValidator(const InlineValidator&) = delete;
+  InlineValidator& operator=(const InlineValidator&) = delete;
+  InlineValidator(InlineValidator&&) = delete;
+  InlineValidator& operator=(InlineValidator&&) = delete;
+
+  /**
+   * @brief Store a callable, replacing the previous one
+   *
+   * @tparam F The callable type; must be invocable as bool(const T&)
+   * @param callable The callable to store
+   */
+  template <typename F>
+  void assign(F&& callable) {
+    using Callable = std::decay_t<F>;
+    static_assert(std::is_invocable_r_v<bool, const Callable&, const T&>,
+                  "validator must be callable as bool(const T&)");
+
+    reset();
+    if constexpr (kStoredInline<Callable>) {
+      // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+      ::new (static_cast<void*>(storage_)) Callable(std::forward<F>(callable));
+      if constexpr (!std::is_trivially_destructible_v<Callable>) {
+        destroy_ = [](void* object) {
+          static_cast<Callable*>(object)->~Callable();
+        };
+      }
+    } else {
+      // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+      auto* heap = new Callable(std::forward<F>(callable));
+      ::new (static_cast<void*>(storage_)) Callable*(heap);
+      heapBytes_ = sizeof(Callable);
+      destroy_ = [](void* object) {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        delete *static_cast<Callable**>(object);
+      };
+    }
+    invoke_ = [](const void* object, const T& value) -> bool {
+      return stored<Callable>(object)(value);
+    };
+    if constexpr (detail::IsDescribable<Callable>::value) {
+      describe_ = [](const void* object, std::string& out) {
+        stored<Callable>(object).describe(out);
+      };
+    }
+    if constexpr (detail::IsCompletable<Callable>::value) {
+      complete_ = [](const void* object, std::string_view prefix,
+                     std::ostream& os) {
+        stored<Callable>(object).complete(prefix, os);
+      };
+    }
+  }
+
+  /**
+   * @brief Remove the stored callable, leaving the validator empty
+   */
+  void reset() {
+    if (destroy_ != nullptr) {
+      destroy_(storage_);
+    }
+    invoke_ = nullptr;
+    destroy_ = nullptr;
+    describe_ = nullptr;
+    complete_ = nullptr;
+    heapBytes_ = 0;
+  }
+
+  /**
+   * @brief Heap bytes held by a callable too large for the inline buffer
+   * @return std::size_t The callable's size, or 0 if it is stored inline
+   */
+  [[nodiscard]] std::size_t heapBytes() const { return heapBytes_; }
+
+  /**
+   * @brief Append a human-readable description of the stored constraint
+   *
+   * Only constraint objects (such as those returned by inRange or oneOf)
+   * describe themselves; plain lambdas append nothing.
+   * @param out The string to append to
+   */
+  void describe(std::string& out) const {
+    if (describe_ != nullptr) {
+      describe_(storage_, out);
+    }
+  }
+
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   *
+   * Only constraints with a fixed set of values (such as oneOf) print
+   * anything.
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void complete(std::string_view prefix, std::ostream& os) const {
+    if (complete_ != nullptr) {
+      complete_(storage_, prefix, os);
+    }
+  }
+
+  /**
+   * @brief Check whether a callable is stored
+   * @return true if a validator is present, false otherwise
+   */
+  explicit operator bool() const { return invoke_ != nullptr; }
+
+  /**
+   * @brief Run the stored validator
+   * @param value The value to validate
+   * @return The validator's verdict
+   * @note Must only be called when a callable is stored.
+   */
+  bool operator()(const T& value) const { return invoke_(storage_, value); }
+};
+
+/**
+ * @brief Constraint accepting values within a closed interval
+ *
+ * Created with inRange(). The check is a constexpr call operator, so it can be
+ * evaluated at compile time (e.g. in a static_assert against a default value)
+ * and is inlined when stored as a validator. The bounds are listed in help.
+ * @tparam T The type of the bounds
+ */
+template <typename T>
+class InRange {
+ private:
+  T lower_;
+  T upper_;
+
+ public:
+  /**
+   * @brief Construct a new InRange constraint
+   *
+   * @param lower The smallest accepted value
+   * @param upper The largest accepted value
+   */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+  constexpr InRange(T lower, T upper) : lower_(lower), upper_(upper) {}
+
+  /**
+   * @brief Check whether a value lies within the range
+   * @param value The value to check
+   * @return true if lower <= value <= upper, false otherwise
+   */
+  template <typename V>
+  constexpr bool operator()(const V& value) const {
+    return !detail::lessThan(value, lower_) && !detail::lessThan(upper_, value);
+  }
+
+  /**
+   * @brief Append the range to a help string
+   * @param out The string to append to
+   */
+  void describe(std::string& out) const {
+    out += "range: ";
+    detail::appendValue(out, lower_);
+    out += " to ";
+    detail::appendValue(out, upper_);
+  }
+};
+
+/**
+ * @brief Constraint accepting only values from a fixed list
+ *
+ * Created with oneOf(). The choices are stored in a std::array, so the
+ * constraint neither allocates nor type-erases; the choices are listed in
+ * help.
+ * @tparam T The type of the choices
+ * @tparam N The number of choices
+ */
+template <typename T, std::size_t N>
+class OneOf {
+ private:
+  std::array<T, N> choices_;
+
+ public:
+  /**
+   * @brief Construct a new OneOf constraint
+   * @param choices The accepted values
+   */
+  constexpr explicit OneOf(const std::array<T, N>& choices)
+      : choices_(choices) {}
+
+  /**
+   * @brief Check whether a value is one of the choices
+   * @param value The value to check
+   * @return true if the value equals one of the choices, false otherwise
+   */
+  template <typename V>
+  constexpr bool operator()(const V& value) const {
+    for (const auto& choice : choices_) {
+      if (detail::equalTo(value, choice)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Get the accepted values
+   * @return The choices, in the order they were given
+   */
+  constexpr const std::array<T, N>& choices() const { return choices_; }
+
+  /**
+   * @brief Print the choices starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void complete(std::string_view prefix, std::ostream& os) const {
+    std::string text;
+    for (const auto& choice : choices_) {
+      text.clear();
+      detail::appendValue(text, choice);
+      if (text.compare(0, prefix.size(), prefix) == 0) {
+        os << text << "\n";
+      }
+    }
+  }
+
+  /**
+   * @brief Append the choices to a help string
+   * @param out The string to append to
+   */
+  void describe(std::string& out) const {
+    out += "one of: ";
+    for (std::size_t i = 0; i < N; ++i) {
+      if (i != 0) {
+        out += ", ";
+      }
+      detail::appendValue(out, choices_[i]);
+    }
+  }
+};
+
+/**
+ * @brief Constraint rejecting empty strings
+ */
+struct NonEmpty {
+  /**
+   * @brief Check whether a value is non-empty
+   * @param value The value to check
+   * @return true if the value is not empty, false otherwise
+   */
+  template <typename V>
+  constexpr bool operator()(const V& value) const {
+    return !value.empty();
+  }
+
+  /**
+   * @brief Append the constraint to a help string
+   * @param out The string to append to
+   */
+  static void describe(std::string& out) { out += "non-empty"; }
+};
+
+/**
+ * @brief Create a constraint accepting values in [lower, upper]
+ *
+ * @param lower The smallest accepted value
+ * @param upper The largest accepted value
+ * @return InRange<T> The constraint
+ */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+template <typename T>
+constexpr InRange<T> inRange(T lower, T upper) {
+  return InRange<T>(lower, upper);
+}
+
+/**
+ * @brief Create a constraint accepting only the given values
+ *
+ * String literals are kept as `const char*`, so oneOf("fast", "slow") does not
+ * allocate.
+ * @param first The first accepted value
+ * @param rest The remaining accepted values
+ * @return OneOf<T, N> The constraint
+ */
+template <typename T, typename... Rest>
+constexpr OneOf<T, 1 + sizeof...(Rest)> oneOf(T first, Rest... rest) {
+  return OneOf<T, 1 + sizeof...(Rest)>(
+      std::array<T, 1 + sizeof...(Rest)>{first, static_cast<T>(rest)...});
+}
+
+/**
+ * @brief Constraint rejecting empty strings
+ */
+inline constexpr NonEmpty nonEmpty{};
+
+/**
+ * @brief Base class for all argument types
+ *
+ * This abstract class defines the interface for all argument types.
+ * Each concrete argument type must implement these methods to handle
+ * parsing, validation, and help display.
+ */
+class ArgumentBase {
+ protected:
+  std::string_view name_;
+  std::string_view shortName_;
+  std::string_view description_;
+  /// Backing store of the three views above if they were copied
+  std::unique_ptr<char[]> ownedStrings_;
+
+  /// std::string copies returned by getName() and friends
+  struct StringCopies {
+    std::string name;
+    std::string shortName;
+    std::string description;
+  };
+  /// Built on the first getName() call; readers may race to build it
+  mutable std::atomic<const StringCopies*> stringCopies_{nullptr};
+
+  /**
+   * @brief Get the std::string copies of the names, building them once
+   */
+  const StringCopies& stringCopies() const {
+    const StringCopies* copies = stringCopies_.load(std::memory_order_acquire);
+    if (copies == nullptr) {
+      auto fresh = std::make_unique<const StringCopies>(
+          StringCopies{std::string(name_), std::string(shortName_),
+                       std::string(description_)});
+      if (stringCopies_.compare_exchange_strong(copies, fresh.get(),
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+        copies = fresh.release();
+      }
+    }
+    return *copies;
+  }
+
+  /**
+   * @brief Drop the std::string copies (the names changed)
+   */
+  void dropStringCopies() {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    delete stringCopies_.exchange(nullptr, std::memory_order_acq_rel);
+  }
+  bool isSet_{false};
+  bool isRequired_{false};
+  ValueSource source_{ValueSource::DEFAULT};
+  std::string envVariable_;
+  std::size_t index_{static_cast<std::size_t>(-1)};
+
+  /**
+   * @brief Run a validator on a freshly converted value
+   *
+   * @param validator The validator to run (must not be empty)
+   * @param value The converted value
+   * @return true if the value was accepted, false otherwise
+   */
+  template <typename V, typename T>
+  bool validate(const V& validator, const T& value) const {
+    ARGSPARSER_PARSE_STEP(VALIDATE, ARGSPARSER_TRACE_INDEX(), name_);
+    return validator(value);
+  }
+
+ public:
+  /**
+   * @brief Construct a new ArgumentBase object
+   *
+   * @param name The name of the argument
+   * @param shortName The short name of the argument
+   * @param description The description of the argument
+   * @param required Whether the argument is required
+   * @note The strings are copied; see setStrings() to reference them instead.
+   */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+  ArgumentBase(std::string_view name, std::string_view shortName,
+               std::string_view description, bool required)
+      : isRequired_(required) {
+    setStrings(name, shortName, description, StringStorage::COPY);
+  }
+
+  /**
+   * @brief Virtual destructor for proper cleanup
+   */
+  virtual ~ArgumentBase() { dropStringCopies(); }
+
+  // Explicitly declare special member functions to comply with
+  // cppcoreguidelines-special-member-functions
+
+  /**
+   * @brief Copy constructor (deleted)
+   */
+  ArgumentBase(const ArgumentBase&) = delete;
+
+  /**
+   * @brief Copy assignment operator (deleted)
+   */
+  ArgumentBase& operator=(const ArgumentBase&) = delete;
+
+  /**
+   * @brief Move constructor (deleted)
+   */
+  ArgumentBase(ArgumentBase&&) = delete;
+
+  /**
+   * @brief Move assignment operator (deleted)
+   */
+  ArgumentBase& operator=(ArgumentBase&&) = delete;
+
+  /**
+   * @brief Parse a string value into the argument's type
+   * @param value The string value to parse
+   * @return true if parsing was successful, false otherwise
+   */
+  virtual bool parse(const std::string& value) = 0;
+
+  /**
+   * @brief Parse a value viewed in argv, a config file or the environment
+   *
+   * The parser calls this instead of parse(). The built-in argument types
+   * convert the view directly; the default copies it into a std::string and
+   * calls parse(), so subclasses that only override parse() keep working.
+   * @param value The string value to parse
+   * @return true if parsing was successful, false otherwise
+   */
+  virtual bool parseView(std::string_view value) {
+    return parse(std::string(value));
+  }
+
+  /**
+   * @brief Print help information for this argument
+   * @param os The output stream to print to
+   */
+  virtual void printHelp(std::ostream& os) const;
+
+  /**
+   * @brief Print the help text that follows the option names
+   *
+   * Prints the description, type, constraint, default and environment
+   * binding; printHelp() is the names line followed by this.
+   * @param os The output stream to print to
+   */
+  void printHelpDetails(std::ostream& os) const;
+
+  /**
+   * @brief Check if this argument has been set
+   * @return true if the argument was provided, false otherwise
+   */
+  [[nodiscard]] bool isSet() const { return isSet_; }
+
+  /**
+   * @brief Mark this argument as not provided, keeping its current value
+   *
+   * Used after converting a default value, which parse() marks as set.
+   */
+  void clearSet() { isSet_ = false; }
+
+  /**
+   * @brief Check if this argument is required
+   * @return true if the argument is required, false otherwise
+   */
+  [[nodiscard]] bool isRequired() const { return isRequired_; }
+
+  /**
+   * @brief Get the name of this argument
+   * @return The argument's name
+   * @note Builds std::string copies of the strings on first use; prefer
+   * getNameView(), which does not allocate.
+   */
+  [[nodiscard]] const std::string& getName() const {
+    return stringCopies().name;
+  }
+
+  /**
+   * @brief Get the short name of this argument
+   * @return The argument's short name
+   * @note Builds std::string copies on first use (see getName())
+   */
+  [[nodiscard]] const std::string& getShortName() const {
+    return stringCopies().shortName;
+  }
+
+  /**
+   * @brief Get the description of this argument
+   * @return The argument's description
+   * @note Builds std::string copies on first use (see getName())
+   */
+  [[nodiscard]] const std::string& getDescription() const {
+    return stringCopies().description;
+  }
+
+  /**
+   * @brief Get the name of this argument without copying it
+   * @return The argument's name
+   */
+  [[nodiscard]] std::string_view getNameView() const { return name_; }
+
+  /**
+   * @brief Get the short name of this argument without copying it
+   * @return The argument's short name
+   */
+  [[nodiscard]] std::string_view getShortNameView() const {
+    return shortName_;
+  }
+
+  /**
+   * @brief Get the description of this argument without copying it
+   * @return The argument's description
+   */
+  [[nodiscard]] std::string_view getDescriptionView() const {
+    return description_;
+  }
+
+  /**
+   * @brief Replace the names and description (used by the parser)
+   *
+   * With StringStorage::COPY all three strings are copied into a single
+   * allocation (none if they are all empty); with REFERENCE nothing is copied
+   * and the caller's storage must outlive the argument.
+   * @param name The long name
+   * @param shortName The short name
+   * @param description The description
+   * @param storage Whether to copy or reference the strings
+   */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+  void setStrings(std::string_view name, std::string_view shortName,
+                  std::string_view description, StringStorage storage) {
+    dropStringCopies();
+    if (storage == StringStorage::REFERENCE) {
+      name_ = name;
+      shortName_ = shortName;
+      description_ = description;
+      ownedStrings_.reset();
+      return;
+    }
+    const std::size_t total =
+        name.size() + shortName.size() + description.size();
+    if (total == 0) {
+      name_ = shortName_ = description_ = std::string_view();
+      ownedStrings_.reset();
+      return;
+    }
+    // The inputs may view the current buffer, so fill the new one first
+    std::unique_ptr<char[]> buffer(new char[total]);
+    char* out = buffer.get();
+    auto place = [&out](std::string_view text) {
+      text.copy(out, text.size());
+      const std::string_view placed(out, text.size());
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      out += text.size();
+      return placed;
+    };
+    name_ = place(name);
+    shortName_ = place(shortName);
+    description_ = place(description);
+    ownedStrings_ = std::move(buffer);
+  }
+
+  /**
+   * @brief Get where the current value came from
+   * @return The source of the current value
+   */
+  [[nodiscard]] ValueSource getSource() const { return source_; }
+
+  /**
+   * @brief Record where the current value came from (used by the parser)
+   * @param source The source of the value that was just parsed
+   */
+  void setSource(ValueSource source) { source_ = source; }
+
+  /**
+   * @brief Get the environment variable bound to this argument
+   * @return The variable name or empty string if none is bound
+   */
+  [[nodiscard]] const std::string& getEnvironmentVariable() const {
+    return envVariable_;
+  }
+
+  /**
+   * @brief Bind an environment variable to this argument (used by the parser)
+   * @param variable The variable name
+   */
+  void setEnvironmentVariable(const std::string& variable) {
+    envVariable_ = variable;
+  }
+
+  /**
+   * @brief Get the position of this option in its parser's option table
+   * @return The index, or SIZE_MAX for positional arguments
+   */
+  [[nodiscard]] std::size_t getIndex() const { return index_; }
+
+  /**
+   * @brief Set the position in the parser's option table (used by the parser)
+   * @param index The index
+   */
+  void setIndex(std::size_t index) { index_ = index; }
+
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   *
+   * Used for shell completion; only arguments constrained to a fixed set of
+   * values (see oneOf) print anything.
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  virtual void printChoices([[maybe_unused]] std::string_view prefix,
+                            [[maybe_unused]] std::ostream& os) const {}
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  virtual void addMemoryUsage(MemoryUsage& usage) const {
+    addObjectMemoryUsage(usage, sizeof(ArgumentBase), 0);
+  }
+
+ protected:
+  /**
+   * @brief Add the object and the strings held by the base to a report
+   * @param usage The report to add to
+   * @param objectSize The size of the most derived object
+   * @param validatorSize The size of its inline validator (0 if none)
+   * @param validatorHeapBytes Heap bytes of an oversized validator
+   */
+  void addObjectMemoryUsage(MemoryUsage& usage, std::size_t objectSize,
+                            std::size_t validatorSize,
+                            std::size_t validatorHeapBytes = 0) const {
+    usage.argumentObjects += objectSize - validatorSize;
+    usage.validators += validatorSize + validatorHeapBytes;
+    if (ownedStrings_) {
+      usage.strings += name_.size() + shortName_.size() + description_.size();
+    }
+    if (const StringCopies* copies =
+            stringCopies_.load(std::memory_order_acquire)) {
+      usage.strings += sizeof(StringCopies) + detail::heapBytes(copies->name) +
+                       detail::heapBytes(copies->shortName) +
+                       detail::heapBytes(copies->description);
+    }
+    usage.strings += detail::heapBytes(envVariable_);
+  }
+
+  /**
+   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
+   * @return The type name or empty string if no type name should be displayed
+   */
+  [[nodiscard]] virtual const char* getTypeName() const { return ""; }
+
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description (e.g., "range: 1 to 10") or empty
+   * string if the validator does not describe itself
+   */
+  [[nodiscard]] virtual std::string getConstraintString() const { return ""; }
+
+  /**
+   * @brief Get the default value as a string
+   * @return String representation of the default value or empty string if no
+   * default
+   */
+  [[nodiscard]] virtual std::string getDefaultString() const { return ""; }
+
+  /**
+   * @brief Check if the argument has a default value that should be displayed
+   * @return true if a default value should be shown, false otherwise
+   */
+  [[nodiscard]] virtual bool hasDefaultValue() const { return false; }
+};
+
+/**
+ * @brief Template class for typed arguments
+ *
+ * This template class provides the base implementation for arguments of any
+ * type. Specializations exist for specific types like std::string, bool, and
+ * int.
+ * @tparam T The type of value this argument holds
+ */
+template <typename T>
+class Argument : public ArgumentBase {
+ public:
+  /**
+   * @brief Validator function type
+   *
+   * A validator is a function that takes a value of type T and returns
+   * true if the value is valid, false otherwise.
+   */
+  using Validator = std::function<bool(const T&)>;
+
+ protected:
+  T value_;
+  InlineValidator<T> validator_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object
+   *
+   * @param name The long name of the argument (e.g., "verbose")
+   * @param shortName The short name of the argument (e.g., "v")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: T{})
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool required = false,
+           const T& defaultValue = T{})
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {}
+
+  /**
+   * @brief Set a validator function for this argument
+   *
+   * The validator function will be called during parsing to validate the value.
+   * @param validator The validator function to use
+   */
+  void setValidator(const Validator& validator) {
+    if (validator) {
+      validator_.assign(validator);
+    } else {
+      validator_.reset();
+    }
+  }
+
+  /**
+   * @brief Set a validator callable for this argument
+   *
+   * The callable is stored inline when it fits, so small capturing lambdas do
+   * not go through std::function and its potential heap allocation.
+   * @tparam F The callable type; must accept the argument's value and return
+   * bool
+   * @param validator The validator callable to use
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Validator>>>
+  void setValidator(F&& validator) {
+    validator_.assign(std::forward<F>(validator));
+  }
+
+  /**
+   * @brief Set a constraint (e.g., inRange, oneOf) and check the default
+   *
+   * The constraint is stored like any other validator and is listed in the
+   * help output. The current (default) value is checked against it, so
+   * out-of-range defaults are caught when the argument is registered.
+   * @tparam C The constraint type
+   * @param constraint The constraint to use
+   * @return true if the default value satisfies the constraint, false
+   * otherwise (the constraint is installed either way)
+   */
+  template <typename C>
+  [[nodiscard]] bool setConstraint(C&& constraint) {
+    const bool defaultIsValid = static_cast<bool>(constraint(value_));
+    validator_.assign(std::forward<C>(constraint));
+    return defaultIsValid;
+  }
+
+  /**
+   * @brief Parse a string value into this argument's type
+   *
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override {
+    if (!parseValue(value)) {
+      return false;
+    }
+
+    if (validator_ && !validate(validator_, value_)) {
+      return false;
+    }
+
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const T& The parsed value
+   */
+  const T& getValue() const { return value_; }
+
+ protected:
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description or empty string if none
+   */
+  [[nodiscard]] std::string getConstraintString() const override {
+    std::string out;
+    validator_.describe(out);
+    return out;
+  }
+
+ public:
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void printChoices(std::string_view prefix, std::ostream& os) const override {
+    validator_.complete(prefix, os);
+  }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), sizeof(validator_),
+                         validator_.heapBytes());
+  }
+
+ protected:
+ private:
+  /**
+   * @brief Parse a string value into this argument's type (pure virtual)
+   *
+   * This method must be implemented by specializations to handle
+   * type-specific parsing.
+   * @param value The string value to parse
+   * @return true if parsing was successful, false otherwise
+   */
+  virtual bool parseValue(const std::string& value) = 0;
+};
+
+/**
+ * @brief Specialization for string arguments
+ *
+ * This specialization handles string arguments, which don't require
+ * type conversion during parsing.
+ */
+template <>
+class Argument<std::string> : public ArgumentBase {
+ public:
+  /**
+   * @brief Validator function type for string arguments
+   *
+   * A validator is a function that takes a string value and returns
+   * true if the value is valid, false otherwise.
+   */
+  using Validator = std::function<bool(const std::string&)>;
+
+ private:
+  std::string value_;
+  InlineValidator<std::string> validator_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object for string values
+   *
+   * @param name The long name of the argument (e.g., "input")
+   * @param shortName The short name of the argument (e.g., "i")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: "")
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool required = false,
+           const std::string& defaultValue = "")
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {}
+
+  /**
+   * @brief Set a validator function for this argument
+   *
+   * The validator function will be called during parsing to validate the value.
+   * @param validator The validator function to use
+   */
+  void setValidator(const Validator& validator) {
+    if (validator) {
+      validator_.assign(validator);
+    } else {
+      validator_.reset();
+    }
+  }
+
+  /**
+   * @brief Set a validator callable for this argument
+   *
+   * The callable is stored inline when it fits, so small capturing lambdas do
+   * not go through std::function and its potential heap allocation.
+   * @tparam F The callable type; must accept the argument's value and return
+   * bool
+   * @param validator The validator callable to use
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Validator>>>
+  void setValidator(F&& validator) {
+    validator_.assign(std::forward<F>(validator));
+  }
+
+  /**
+   * @brief Set a constraint (e.g., inRange, oneOf) and check the default
+   *
+   * The constraint is stored like any other validator and is listed in the
+   * help output. The current (default) value is checked against it, so
+   * out-of-range defaults are caught when the argument is registered.
+   * @tparam C The constraint type
+   * @param constraint The constraint to use
+   * @return true if the default value satisfies the constraint, false
+   * otherwise (the constraint is installed either way)
+   */
+  template <typename C>
+  [[nodiscard]] bool setConstraint(C&& constraint) {
+    const bool defaultIsValid = static_cast<bool>(constraint(value_));
+    validator_.assign(std::forward<C>(constraint));
+    return defaultIsValid;
+  }
+
+  /**
+   * @brief Parse a string value (see parseView())
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override { return parseView(value); }
+
+  /**
+   * @brief Parse a string value for this argument
+   *
+   * For string arguments, parsing is trivial - we just assign the value.
+   * The value is validated first, so a rejected value leaves the current
+   * one in place.
+   * @param value The string value to parse
+   * @return true if validation was successful, false otherwise
+   */
+  bool parseView(std::string_view value) override {
+    if (validator_) {
+      std::string candidate(value);
+      if (!validate(validator_, candidate)) {
+        return false;
+      }
+      value_ = std::move(candidate);
+    } else {
+      convertValue(value, value_);
+    }
+
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const std::string& The parsed value
+   */
+  [[nodiscard]] const std::string& getValue() const { return value_; }
+
+ protected:
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description or empty string if none
+   */
+  [[nodiscard]] std::string getConstraintString() const override {
+    std::string out;
+    validator_.describe(out);
+    return out;
+  }
+
+ public:
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void printChoices(std::string_view prefix, std::ostream& os) const override {
+    validator_.complete(prefix, os);
+  }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), sizeof(validator_),
+                         validator_.heapBytes());
+    usage.strings += detail::heapBytes(value_);
+  }
+
+ protected:
+  /**
+   * @brief Get the default value as a string
+   * @return String representation of the default value or empty string if no
+   * default
+   */
+  [[nodiscard]] std::string getDefaultString() const override { return value_; }
+
+  /**
+   * @brief Check if the argument has a default value that should be displayed
+   * @return true if a default value should be shown, false otherwise
+   */
+  [[nodiscard]] bool hasDefaultValue() const override {
+    return !value_.empty();
+  }
+};
+
+/**
+ * @brief Specialization for boolean arguments (flags)
+ *
+ * This specialization handles boolean arguments, which are treated as flags.
+ * Flags don't take values; their presence sets them to true.
+ */
+template <>
+class Argument<bool> : public ArgumentBase {
+ private:
+  bool value_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object for boolean values (flags)
+   *
+   * @param name The long name of the argument (e.g., "verbose")
+   * @param shortName The short name of the argument (e.g., "v")
+   * @param description Description of the argument
+   * @param defaultValue Default value for the argument
+   * @param required Whether the argument is required (not typically used for
+   * flags)
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool defaultValue,
+           [[maybe_unused]] bool required)
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {
+    // Flags are never required
+    isRequired_ = false;
+  }
+
+  /**
+   * @brief Parse a string value (see parseView())
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override { return parseView(value); }
+
+  /**
+   * @brief Parse a value for this boolean argument (flags)
+   *
+   * On the command line a flag's presence sets it to true (the parser passes
+   * "true"). Other sources such as config files may spell the value out.
+   * @param value "true", "1", "yes", "on" or empty for true; "false", "0",
+   * "no" or "off" for false
+   * @return true if the value was recognized, false otherwise
+   */
+  bool parseView(std::string_view value) override {
+    if (!convertValue(value, value_)) {
+      return false;
+    }
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const bool& The parsed value (true if flag was present)
+   */
+  [[nodiscard]] const bool& getValue() const { return value_; }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), 0);
+  }
+
+ protected:
+  /**
+   * @brief Get the default value as a string
+   * @return String representation of the default value or empty string if no
+   * default
+   */
+  [[nodiscard]] std::string getDefaultString() const override {
+    return value_ ? "true" : "";
+  }
+
+  /**
+   * @brief Check if the argument has a default value that should be displayed
+   * @return true if a default value should be shown, false otherwise
+   */
+  [[nodiscard]] bool hasDefaultValue() const override { return value_; }
+};
+
+/**
+ * @brief Specialization for 16-bit integer arguments
+ *
+ * This specialization handles 16-bit integer arguments, which require
+ * conversion from string to int16_t during parsing.
+ */
+template <>
+class Argument<int16_t> : public ArgumentBase {
+ public:
+  /**
+   * @brief Validator function type for 16-bit integer arguments
+   *
+   * A validator is a function that takes an int16_t value and returns
+   * true if the value is valid, false otherwise.
+   */
+  using Validator = std::function<bool(int16_t)>;
+
+ private:
+  int16_t value_;
+  InlineValidator<int16_t> validator_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object for 16-bit integer values
+   *
+   * @param name The long name of the argument (e.g., "count")
+   * @param shortName The short name of the argument (e.g., "c")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: 0)
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool required = false,
+           int16_t defaultValue = 0)
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {}
+
+  /**
+   * @brief Set a validator function for this argument
+   *
+   * The validator function will be called during parsing to validate the value.
+   * @param validator The validator function to use
+   */
+  void setValidator(const Validator& validator) {
+    if (validator) {
+      validator_.assign(validator);
+    } else {
+      validator_.reset();
+    }
+  }
+
+  /**
+   * @brief Set a validator callable for this argument
+   *
+   * The callable is stored inline when it fits, so small capturing lambdas do
+   * not go through std::function and its potential heap allocation.
+   * @tparam F The callable type; must accept the argument's value and return
+   * bool
+   * @param validator The validator callable to use
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Validator>>>
+  void setValidator(F&& validator) {
+    validator_.assign(std::forward<F>(validator));
+  }
+
+  /**
+   * @brief Set a constraint (e.g., inRange, oneOf) and check the default
+   *
+   * The constraint is stored like any other validator and is listed in the
+   * help output. The current (default) value is checked against it, so
+   * out-of-range defaults are caught when the argument is registered.
+   * @tparam C The constraint type
+   * @param constraint The constraint to use
+   * @return true if the default value satisfies the constraint, false
+   * otherwise (the constraint is installed either way)
+   */
+  template <typename C>
+  [[nodiscard]] bool setConstraint(C&& constraint) {
+    const bool defaultIsValid = static_cast<bool>(constraint(value_));
+    validator_.assign(std::forward<C>(constraint));
+    return defaultIsValid;
+  }
+
+  /**
+   * @brief Parse a string value (see parseView())
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override { return parseView(value); }
+
+  /**
+   * @brief Parse a string value into a 16-bit integer
+   *
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parseView(std::string_view value) override {
+    if (!convertValue(value, value_)) {
+      return false;
+    }
+
+    if (validator_ && !validate(validator_, value_)) {
+      return false;
+    }
+
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const int16_t& The parsed value
+   */
+  [[nodiscard]] const int16_t& getValue() const { return value_; }
+
+ protected:
+  /**
+   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
+   * @return The type name or empty string if no type name should be displayed
+   */
+  [[nodiscard]] const char* getTypeName() const override {
+    return "(16-bit integer)";
+  }
+
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description or empty string if none
+   */
+  [[nodiscard]] std::string getConstraintString() const override {
+    std::string out;
+    validator_.describe(out);
+    return out;
+  }
+
+ public:
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void printChoices(std::string_view prefix, std::ostream& os) const override {
+    validator_.complete(prefix, os);
+  }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), sizeof(validator_),
+                         validator_.heapBytes());
+  }
+
+ protected:
+  /**
+
+   * @brief Get the default value as a string
+
+   * @return String representation of the default value or empty string if no
+
+   * default
+
+   */
+
+  [[nodiscard]] std::string getDefaultString() const override {
+    return std::to_string(value_);
+  }
+
+  /**
+
+   * @brief Check if the argument has a default value that should be displayed
+
+   * @return true if a default value should be shown, false otherwise
+
+   */
+
+  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
+};
+
+/**
+ * @brief Specialization for 32-bit unsigned integer arguments
+ *
+ * This specialization handles 32-bit unsigned integer arguments, which require
+ * conversion from string to uint32_t during parsing.
+ */
+template <>
+class Argument<uint32_t> : public ArgumentBase {
+ public:
+  /**
+   * @brief Validator function type for 32-bit unsigned integer arguments
+   *
+   * A validator is a function that takes a uint32_t value and returns
+   * true if the value is valid, false otherwise.
+   */
+  using Validator = std::function<bool(uint32_t)>;
+
+ private:
+  uint32_t value_;
+  InlineValidator<uint32_t> validator_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object for 32-bit unsigned integer values
+   *
+   * @param name The long name of the argument (e.g., "count")
+   * @param shortName The short name of the argument (e.g., "c")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: 0)
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool required = false,
+           uint32_t defaultValue = 0)
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {}
+
+  /**
+   * @brief Set a validator function for this argument
+   *
+   * The validator function will be called during parsing to validate the value.
+   * @param validator The validator function to use
+   */
+  void setValidator(const Validator& validator) {
+    if (validator) {
+      validator_.assign(validator);
+    } else {
+      validator_.reset();
+    }
+  }
+
+  /**
+   * @brief Set a validator callable for this argument
+   *
+   * The callable is stored inline when it fits, so small capturing lambdas do
+   * not go through std::function and its potential heap allocation.
+   * @tparam F The callable type; must accept the argument's value and return
+   * bool
+   * @param validator The validator callable to use
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Validator>>>
+  void setValidator(F&& validator) {
+    validator_.assign(std::forward<F>(validator));
+  }
+
+  /**
+   * @brief Set a constraint (e.g., inRange, oneOf) and check the default
+   *
+   * The constraint is stored like any other validator and is listed in the
+   * help output. The current (default) value is checked against it, so
+   * out-of-range defaults are caught when the argument is registered.
+   * @tparam C The constraint type
+   * @param constraint The constraint to use
+   * @return true if the default value satisfies the constraint, false
+   * otherwise (the constraint is installed either way)
+   */
+  template <typename C>
+  [[nodiscard]] bool setConstraint(C&& constraint) {
+    const bool defaultIsValid = static_cast<bool>(constraint(value_));
+    validator_.assign(std::forward<C>(constraint));
+    return defaultIsValid;
+  }
+
+  /**
+   * @brief Parse a string value (see parseView())
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override { return parseView(value); }
+
+  /**
+   * @brief Parse a string value into a 32-bit unsigned integer
+   *
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   * @note Negative values will be rejected even if they would fit in the
+   * unsigned type.
+   */
+  bool parseView(std::string_view value) override {
+    if (!convertValue(value, value_)) {
+      return false;
+    }
+
+    if (validator_ && !validate(validator_, value_)) {
+      return false;
+    }
+
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const uint32_t& The parsed value
+   */
+  [[nodiscard]] const uint32_t& getValue() const { return value_; }
+
+ protected:
+  /**
+   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
+   * @return The type name or empty string if no type name should be displayed
+   */
+  [[nodiscard]] const char* getTypeName() const override {
+    return "(32-bit unsigned integer)";
+  }
+
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description or empty string if none
+   */
+  [[nodiscard]] std::string getConstraintString() const override {
+    std::string out;
+    validator_.describe(out);
+    return out;
+  }
+
+ public:
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void printChoices(std::string_view prefix, std::ostream& os) const override {
+    validator_.complete(prefix, os);
+  }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), sizeof(validator_),
+                         validator_.heapBytes());
+  }
+
+ protected:
+  /**
+   * @brief Get the default value as a string
+   * @return String representation of the default value or empty string if no
+   * default
+   */
+  [[nodiscard]] std::string getDefaultString() const override {
+    return std::to_string(value_);
+  }
+
+  /**
+   * @brief Check if the argument has a default value that should be displayed
+   * @return true if a default value should be shown, false otherwise
+   */
+  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
+};
+
+/**
+ * @brief Specialization for 32-bit integer arguments
+ *
+ * This specialization handles 32-bit integer arguments, which require
+ * conversion from string to int32_t during parsing.
+ */
+template <>
+class Argument<int32_t> : public ArgumentBase {
+ public:
+  /**
+   * @brief Validator function type for 32-bit integer arguments
+   *
+   * A validator is a function that takes an int32_t value and returns
+   * true if the value is valid, false otherwise.
+   */
+  using Validator = std::function<bool(int32_t)>;
+
+ private:
+  int32_t value_;
+  InlineValidator<int32_t> validator_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object for 32-bit integer values
+   *
+   * @param name The long name of the argument (e.g., "count")
+   * @param shortName The short name of the argument (e.g., "c")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: 0)
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool required = false,
+           int32_t defaultValue = 0)
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {}
+
+  /**
+   * @brief Set a validator function for this argument
+   *
+   * The validator function will be called during parsing to validate the value.
+   * @param validator The validator function to use
+   */
+  void setValidator(const Validator& validator) {
+    if (validator) {
+      validator_.assign(validator);
+    } else {
+      validator_.reset();
+    }
+  }
+
+  /**
+   * @brief Set a validator callable for this argument
+   *
+   * The callable is stored inline when it fits, so small capturing lambdas do
+   * not go through std::function and its potential heap allocation.
+   * @tparam F The callable type; must accept the argument's value and return
+   * bool
+   * @param validator The validator callable to use
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Validator>>>
+  void setValidator(F&& validator) {
+    validator_.assign(std::forward<F>(validator));
+  }
+
+  /**
+   * @brief Set a constraint (e.g., inRange, oneOf) and check the default
+   *
+   * The constraint is stored like any other validator and is listed in the
+   * help output. The current (default) value is checked against it, so
+   * out-of-range defaults are caught when the argument is registered.
+   * @tparam C The constraint type
+   * @param constraint The constraint to use
+   * @return true if the default value satisfies the constraint, false
+   * otherwise (the constraint is installed either way)
+   */
+  template <typename C>
+  [[nodiscard]] bool setConstraint(C&& constraint) {
+    const bool defaultIsValid = static_cast<bool>(constraint(value_));
+    validator_.assign(std::forward<C>(constraint));
+    return defaultIsValid;
+  }
+
+  /**
+   * @brief Parse a string value (see parseView())
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override { return parseView(value); }
+
+  /**
+   * @brief Parse a string value into a 32-bit integer
+   *
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parseView(std::string_view value) override {
+    if (!convertValue(value, value_)) {
+      return false;
+    }
+
+    if (validator_ && !validate(validator_, value_)) {
+      return false;
+    }
+
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const int32_t& The parsed value
+   */
+  [[nodiscard]] const int32_t& getValue() const { return value_; }
+
+ protected:
+  /**
+   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
+   * @return The type name or empty string if no type name should be displayed
+   */
+  [[nodiscard]] const char* getTypeName() const override {
+    return "(32-bit integer)";
+  }
+
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description or empty string if none
+   */
+  [[nodiscard]] std::string getConstraintString() const override {
+    std::string out;
+    validator_.describe(out);
+    return out;
+  }
+
+ public:
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void printChoices(std::string_view prefix, std::ostream& os) const override {
+    validator_.complete(prefix, os);
+  }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), sizeof(validator_),
+                         validator_.heapBytes());
+  }
+
+ protected:
+  /**
+   * @brief Get the default value as a string
+   * @return String representation of the default value or empty string if no
+   * default
+   */
+  [[nodiscard]] std::string getDefaultString() const override {
+    return std::to_string(value_);
+  }
+
+  /**
+   * @brief Check if the argument has a default value that should be displayed
+   * @return true if a default value should be shown, false otherwise
+   */
+  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
+};
+
+/**
+ * @brief Specialization for 64-bit unsigned integer arguments
+ *
+ * This specialization handles 64-bit unsigned integer arguments, which require
+ * conversion from string to uint64_t during parsing.
+ */
+template <>
+class Argument<uint64_t> : public ArgumentBase {
+ public:
+  /**
+   * @brief Validator function type for 64-bit unsigned integer arguments
+   *
+   * A validator is a function that takes a uint64_t value and returns
+   * true if the value is valid, false otherwise.
+   */
+  using Validator = std::function<bool(uint64_t)>;
+
+ private:
+  uint64_t value_;
+  InlineValidator<uint64_t> validator_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object for 64-bit unsigned integer values
+   *
+   * @param name The long name of the argument (e.g., "count")
+   * @param shortName The short name of the argument (e.g., "c")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: 0)
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool required = false,
+           uint64_t defaultValue = 0)
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {}
+
+  /**
+   * @brief Set a validator function for this argument
+   *
+   * The validator function will be called during parsing to validate the value.
+   * @param validator The validator function to use
+   */
+  void setValidator(const Validator& validator) {
+    if (validator) {
+      validator_.assign(validator);
+    } else {
+      validator_.reset();
+    }
+  }
+
+  /**
+   * @brief Set a validator callable for this argument
+   *
+   * The callable is stored inline when it fits, so small capturing lambdas do
+   * not go through std::function and its potential heap allocation.
+   * @tparam F The callable type; must accept the argument's value and return
+   * bool
+   * @param validator The validator callable to use
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Validator>>>
+  void setValidator(F&& validator) {
+    validator_.assign(std::forward<F>(validator));
+  }
+
+  /**
+   * @brief Set a constraint (e.g., inRange, oneOf) and check the default
+   *
+   * The constraint is stored like any other validator and is listed in the
+   * help output. The current (default) value is checked against it, so
+   * out-of-range defaults are caught when the argument is registered.
+   * @tparam C The constraint type
+   * @param constraint The constraint to use
+   * @return true if the default value satisfies the constraint, false
+   * otherwise (the constraint is installed either way)
+   */
+  template <typename C>
+  [[nodiscard]] bool setConstraint(C&& constraint) {
+    const bool defaultIsValid = static_cast<bool>(constraint(value_));
+    validator_.assign(std::forward<C>(constraint));
+    return defaultIsValid;
+  }
+
+  /**
+   * @brief Parse a string value (see parseView())
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override { return parseView(value); }
+
+  /**
+   * @brief Parse a string value into a 64-bit unsigned integer
+   *
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   * @note Negative values will be rejected even if they would fit in the
+   * unsigned type.
+   */
+  bool parseView(std::string_view value) override {
+    if (!convertValue(value, value_)) {
+      return false;
+    }
+
+    if (validator_ && !validate(validator_, value_)) {
+      return false;
+    }
+
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const uint64_t& The parsed value
+   */
+  [[nodiscard]] const uint64_t& getValue() const { return value_; }
+
+ protected:
+  /**
+   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
+   * @return The type name or empty string if no type name should be displayed
+   */
+  [[nodiscard]] const char* getTypeName() const override {
+    return "(64-bit unsigned integer)";
+  }
+
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description or empty string if none
+   */
+  [[nodiscard]] std::string getConstraintString() const override {
+    std::string out;
+    validator_.describe(out);
+    return out;
+  }
+
+ public:
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void printChoices(std::string_view prefix, std::ostream& os) const override {
+    validator_.complete(prefix, os);
+  }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), sizeof(validator_),
+                         validator_.heapBytes());
+  }
+
+ protected:
+  /**
+   * @brief Get the default value as a string
+   * @return String representation of the default value or empty string if no
+   * default
+   */
+  [[nodiscard]] std::string getDefaultString() const override {
+    return std::to_string(value_);
+  }
+
+  /**
+   * @brief Check if the argument has a default value that should be displayed
+   * @return true if a default value should be shown, false otherwise
+   */
+  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
+};
+
+/**
+ * @brief Specialization for 64-bit integer arguments
+ *
+ * This specialization handles 64-bit integer arguments, which require
+ * conversion from string to int64_t during parsing.
+ */
+template <>
+class Argument<int64_t> : public ArgumentBase {
+ public:
+  /**
+   * @brief Validator function type for 64-bit integer arguments
+   *
+   * A validator is a function that takes an int64_t value and returns
+   * true if the value is valid, false otherwise.
+   */
+  using Validator = std::function<bool(int64_t)>;
+
+ private:
+  int64_t value_;
+  InlineValidator<int64_t> validator_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object for 64-bit integer values
+   *
+   * @param name The long name of the argument (e.g., "count")
+   * @param shortName The short name of the argument (e.g., "c")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: 0)
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool required = false,
+           int64_t defaultValue = 0)
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {}
+
+  /**
+   * @brief Set a validator function for this argument
+   *
+   * The validator function will be called during parsing to validate the value.
+   * @param validator The validator function to use
+   */
+  void setValidator(const Validator& validator) {
+    if (validator) {
+      validator_.assign(validator);
+    } else {
+      validator_.reset();
+    }
+  }
+
+  /**
+   * @brief Set a validator callable for this argument
+   *
+   * The callable is stored inline when it fits, so small capturing lambdas do
+   * not go through std::function and its potential heap allocation.
+   * @tparam F The callable type; must accept the argument's value and return
+   * bool
+   * @param validator The validator callable to use
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Validator>>>
+  void setValidator(F&& validator) {
+    validator_.assign(std::forward<F>(validator));
+  }
+
+  /**
+   * @brief Set a constraint (e.g., inRange, oneOf) and check the default
+   *
+   * The constraint is stored like any other validator and is listed in the
+   * help output. The current (default) value is checked against it, so
+   * out-of-range defaults are caught when the argument is registered.
+   * @tparam C The constraint type
+   * @param constraint The constraint to use
+   * @return true if the default value satisfies the constraint, false
+   * otherwise (the constraint is installed either way)
+   */
+  template <typename C>
+  [[nodiscard]] bool setConstraint(C&& constraint) {
+    const bool defaultIsValid = static_cast<bool>(constraint(value_));
+    validator_.assign(std::forward<C>(constraint));
+    return defaultIsValid;
+  }
+
+  /**
+   * @brief Parse a string value (see parseView())
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override { return parseView(value); }
+
+  /**
+   * @brief Parse a string value into a 64-bit integer
+   *
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parseView(std::string_view value) override {
+    if (!convertValue(value, value_)) {
+      return false;
+    }
+
+    if (validator_ && !validate(validator_, value_)) {
+      return false;
+    }
+
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const int64_t& The parsed value
+   */
+  [[nodiscard]] const int64_t& getValue() const { return value_; }
+
+ protected:
+  /**
+   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
+   * @return The type name or empty string if no type name should be displayed
+   */
+  [[nodiscard]] const char* getTypeName() const override {
+    return "(64-bit integer)";
+  }
+
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description or empty string if none
+   */
+  [[nodiscard]] std::string getConstraintString() const override {
+    std::string out;
+    validator_.describe(out);
+    return out;
+  }
+
+ public:
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void printChoices(std::string_view prefix, std::ostream& os) const override {
+    validator_.complete(prefix, os);
+  }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), sizeof(validator_),
+                         validator_.heapBytes());
+  }
+
+ protected:
+  /**
+   * @brief Get the default value as a string
+   * @return String representation of the default value or empty string if no
+   * default
+   */
+  [[nodiscard]] std::string getDefaultString() const override {
+    return std::to_string(value_);
+  }
+
+  /**
+   * @brief Check if the argument has a default value that should be displayed
+   * @return true if a default value should be shown, false otherwise
+   */
+  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
+};
+
+/**
+ * @brief Specialization for single-precision floating-point arguments
+ *
+ * This specialization handles single-precision floating-point arguments, which
+ * require conversion from string to float during parsing.
+ */
+template <>
+class Argument<float> : public ArgumentBase {
+ public:
+  /**
+   * @brief Validator function type for single-precision floating-point
+   * arguments
+   *
+   * A validator is a function that takes a float value and returns
+   * true if the value is valid, false otherwise.
+   */
+  using Validator = std::function<bool(float)>;
+
+ private:
+  float value_;
+  InlineValidator<float> validator_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object for single-precision floating-point
+   * values
+   *
+   * @param name The long name of the argument (e.g., "rate")
+   * @param shortName The short name of the argument (e.g., "r")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: 0.0f)
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool required = false,
+           float defaultValue = 0.0F)
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {}
+
+  /**
+   * @brief Set a validator function for this argument
+   *
+   * The validator function will be called during parsing to validate the value.
+   * @param validator The validator function to use
+   */
+  void setValidator(const Validator& validator) {
+    if (validator) {
+      validator_.assign(validator);
+    } else {
+      validator_.reset();
+    }
+  }
+
+  /**
+   * @brief Set a validator callable for this argument
+   *
+   * The callable is stored inline when it fits, so small capturing lambdas do
+   * not go through std::function and its potential heap allocation.
+   * @tparam F The callable type; must accept the argument's value and return
+   * bool
+   * @param validator The validator callable to use
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Validator>>>
+  void setValidator(F&& validator) {
+    validator_.assign(std::forward<F>(validator));
+  }
+
+  /**
+   * @brief Set a constraint (e.g., inRange, oneOf) and check the default
+   *
+   * The constraint is stored like any other validator and is listed in the
+   * help output. The current (default) value is checked against it, so
+   * out-of-range defaults are caught when the argument is registered.
+   * @tparam C The constraint type
+   * @param constraint The constraint to use
+   * @return true if the default value satisfies the constraint, false
+   * otherwise (the constraint is installed either way)
+   */
+  template <typename C>
+  [[nodiscard]] bool setConstraint(C&& constraint) {
+    const bool defaultIsValid = static_cast<bool>(constraint(value_));
+    validator_.assign(std::forward<C>(constraint));
+    return defaultIsValid;
+  }
+
+  /**
+   * @brief Parse a string value (see parseView())
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override { return parseView(value); }
+
+  /**
+   * @brief Parse a string value into a single-precision floating-point number
+   *
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   * @note Handles scientific notation (e.g., 1e-5, 2.5E+3) and standard
+   * decimal formats.
+   */
+  bool parseView(std::string_view value) override {
+    if (!convertValue(value, value_)) {
+      return false;
+    }
+
+    if (validator_ && !validate(validator_, value_)) {
+      return false;
+    }
+
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const float& The parsed value
+   */
+  [[nodiscard]] const float& getValue() const { return value_; }
+
+ protected:
+  /**
+   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
+   * @return The type name or empty string if no type name should be displayed
+   */
+  [[nodiscard]] const char* getTypeName() const override { return "(float)"; }
+
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description or empty string if none
+   */
+  [[nodiscard]] std::string getConstraintString() const override {
+    std::string out;
+    validator_.describe(out);
+    return out;
+  }
+
+ public:
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void printChoices(std::string_view prefix, std::ostream& os) const override {
+    validator_.complete(prefix, os);
+  }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), sizeof(validator_),
+                         validator_.heapBytes());
+  }
+
+ protected:
+  /**
+   * @brief Format a float value to a string without trailing zeros
+   * @param value The float value to format
+   * @return Formatted string representation
+   */
+  static std::string formatFloat(float value) {
+    constexpr size_t size = 32;
+    std::array<char, size> buffer{};
+    int len = std::snprintf(buffer.data(), buffer.size(), "%.6g", value);
+    if (len < 0 || static_cast<std::size_t>(len) >= buffer.size()) {
+      // Fallback to scientific notation if buffer is too small
+      len = std::snprintf(buffer.data(), buffer.size(), "%.6e", value);
+      if (len < 0 || static_cast<std::size_t>(len) >= buffer.size()) {
+        return std::string{};
+      }
+    }
+    return {buffer.begin(), buffer.begin() + len};
+  }
+
+  /**
+   * @brief Get the default value as a string
+   * @return String representation of the default value or empty string if no
+   * default
+   */
+  [[nodiscard]] std::string getDefaultString() const override {
+    return Argument<float>::formatFloat(value_);
+  }
+
+  /**
+   * @brief Check if the argument has a default value that should be displayed
+   * @return true if a default value should be shown, false otherwise
+   */
+  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0.0F; }
+};
+
+/**
+ * @brief Specialization for double-precision floating-point arguments
+ *
+ * This specialization handles double-precision floating-point arguments, which
+ * require conversion from string to double during parsing.
+ */
+template <>
+class Argument<double> : public ArgumentBase {
+ public:
+  /**
+   * @brief Validator function type for double-precision floating-point
+   * arguments
+   *
+   * A validator is a function that takes a double value and returns
+   * true if the value is valid, false otherwise.
+   */
+  using Validator = std::function<bool(double)>;
+
+ private:
+  double value_;
+  InlineValidator<double> validator_;
+
+ public:
+  /**
+   * @brief Construct a new Argument object for double-precision floating-point
+   * values
+   *
+   * @param name The long name of the argument (e.g., "precision")
+   * @param shortName The short name of the argument (e.g., "p")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: 0.0)
+   */
+  Argument(std::string_view name, std::string_view shortName,
+           std::string_view description, bool required = false,
+           double defaultValue = 0.0)
+      : ArgumentBase(name, shortName, description, required),
+        value_(defaultValue) {}
+
+  /**
+   * @brief Set a validator function for this argument
+   *
+   * The validator function will be called during parsing to validate the value.
+   * @param validator The validator function to use
+   */
+  void setValidator(const Validator& validator) {
+    if (validator) {
+      validator_.assign(validator);
+    } else {
+      validator_.reset();
+    }
+  }
+
+  /**
+   * @brief Set a validator callable for this argument
+   *
+   * The callable is stored inline when it fits, so small capturing lambdas do
+   * not go through std::function and its potential heap allocation.
+   * @tparam F The callable type; must accept the argument's value and return
+   * bool
+   * @param validator The validator callable to use
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Validator>>>
+  void setValidator(F&& validator) {
+    validator_.assign(std::forward<F>(validator));
+  }
+
+  /**
+   * @brief Set a constraint (e.g., inRange, oneOf) and check the default
+   *
+   * The constraint is stored like any other validator and is listed in the
+   * help output. The current (default) value is checked against it, so
+   * out-of-range defaults are caught when the argument is registered.
+   * @tparam C The constraint type
+   * @param constraint The constraint to use
+   * @return true if the default value satisfies the constraint, false
+   * otherwise (the constraint is installed either way)
+   */
+  template <typename C>
+  [[nodiscard]] bool setConstraint(C&& constraint) {
+    const bool defaultIsValid = static_cast<bool>(constraint(value_));
+    validator_.assign(std::forward<C>(constraint));
+    return defaultIsValid;
+  }
+
+  /**
+   * @brief Parse a string value (see parseView())
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   */
+  bool parse(const std::string& value) override { return parseView(value); }
+
+  /**
+   * @brief Parse a string value into a double-precision floating-point number
+   *
+   * @param value The string value to parse
+   * @return true if parsing and validation were successful, false otherwise
+   * @note Handles scientific notation (e.g., 1e-5, 2.5E+3) and standard
+   * decimal formats.
+   */
+  bool parseView(std::string_view value) override {
+    if (!convertValue(value, value_)) {
+      return false;
+    }
+
+    if (validator_ && !validate(validator_, value_)) {
+      return false;
+    }
+
+    isSet_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Get the parsed value of this argument
+   *
+   * @return const double& The parsed value
+   */
+  [[nodiscard]] const double& getValue() const { return value_; }
+
+ protected:
+  /**
+   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
+   * @return The type name or empty string if no type name should be displayed
+   */
+  [[nodiscard]] const char* getTypeName() const override { return "(double)"; }
+
+  /**
+   * @brief Get a description of the constraint attached to this argument
+   * @return The constraint description or empty string if none
+   */
+  [[nodiscard]] std::string getConstraintString() const override {
+    std::string out;
+    validator_.describe(out);
+    return out;
+  }
+
+ public:
+  /**
+   * @brief Print the accepted values starting with a prefix, one per line
+   * @param prefix The partial value typed so far
+   * @param os The output stream to print to
+   */
+  void printChoices(std::string_view prefix, std::ostream& os) const override {
+    validator_.complete(prefix, os);
+  }
+
+  /**
+   * @brief Add this argument's heap footprint to a memory report
+   * @param usage The report to add to
+   */
+  void addMemoryUsage(MemoryUsage& usage) const override {
+    addObjectMemoryUsage(usage, sizeof(*this), sizeof(validator_),
+                         validator_.heapBytes());
+  }
+
+ protected:
+  /**
+   * @brief Format a double value to a string without trailing zeros
+   * @param value The double value to format
+   * @return Formatted string representation
+   */
+  static std::string formatDouble(double value) {
+    constexpr size_t size = 32;
+    std::array<char, size> buffer{};
+    int len = std::snprintf(buffer.data(), buffer.size(), "%.15g", value);
+    if (len < 0 || static_cast<std::size_t>(len) >= buffer.size()) {
+      // Fallback to scientific notation if buffer is too small
+      len = std::snprintf(buffer.data(), buffer.size(), "%.15e", value);
+      if (len < 0 || static_cast<std::size_t>(len) >= buffer.size()) {
+        return std::string{};
+      }
+    }
+    return {buffer.begin(), buffer.begin() + len};
+  }
+
+  /**
+   * @brief Get the default value as a string
+   * @return String representation of the default value or empty string if no
+   * default
+   */
+  [[nodiscard]] std::string getDefaultString() const override {
+    return Argument<double>::formatDouble(value_);
+  }
+
+  /**
+   * @brief Check if the argument has a default value that should be displayed
+   * @return true if a default value should be shown, false otherwise
+   */
+  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0.0; }
+};
+
+/**
+ * @brief Print help information for this argument
+ * @param os The output stream to print to
+ */
+inline void ArgumentBase::printHelp(std::ostream& os) const {
+  if (!shortName_.empty()) {
+    os << "  -" << shortName_ << ", --" << name_;
+  } else {
+    os << "  --" << name_;
+  }
+  if (isRequired_) {
+    os << " (required)";
+  }
+  printHelpDetails(os);
+}
+
+inline void ArgumentBase::printHelpDetails(std::ostream& os) const {
+  os << "\n    " << description_;
+
+  // Add type name if applicable
+  const char* typeName = getTypeName();
+  if (*typeName != '\0') {
+    os << " " << typeName;
+  }
+
+  // Add constraint if applicable
+  const std::string constraint = getConstraintString();
+  if (!constraint.empty()) {
+    os << " (" << constraint << ")";
+  }
+
+  // Add default value if applicable
+  if (hasDefaultValue()) {
+    const std::string defaultStr = getDefaultString();
+    if (!defaultStr.empty()) {
+      os << " (default: " << defaultStr << ")";
+    }
+  }
+
+  // Add bound environment variable if applicable
+  if (!envVariable_.empty()) {
+    os << " (env: " << envVariable_ << ")";
+  }
+  os << "\n";
+}
+
+/**
+ * @brief Typed, constant-time access to one argument's value and set state
+ *
+ * Converts from the Argument<T>* returned by addArgument() and
+ * addPositionalArgument(), or is resolved once by name with
+ * Parser::getHandle(). Reading through a handle is a load from the argument
+ * object: no lookup, cast or virtual call.
+ * @tparam T The value type of the argument
+ */
+template <typename T>
+class ArgumentHandle {
+ private:
+  const Argument<T>* argument_{nullptr};
+
+ public:
+  /**
+   * @brief Construct an empty handle
+   */
+  ArgumentHandle() = default;
+
+  /**
+   * @brief Construct a handle for a registered argument
+   * @param argument The argument, owned by its parser (may be nullptr)
+   */ // NOLINTNEXTLINE(hicpp-explicit-conversions)
+  ArgumentHandle(const Argument<T>* argument) : argument_(argument) {}
+
+  /**
+   * @brief Check whether the handle refers to an argument
+   */
+  explicit operator bool() const { return argument_ != nullptr; }
+
+  /**
+   * @brief Get the argument's value (the handle must not be empty)
+   * @return const T& The current value
+   */
+  [[nodiscard]] const T& getValue() const { return argument_->getValue(); }
+
+  /**
+   * @brief Check whether the argument received a value
+   * @return true if it was given on the command line, in the environment or
+   * in a config file
+   */
+  [[nodiscard]] bool isSet() const { return argument_->isSet(); }
+};
+
+/**
+ * @brief Compact storage for very large numbers of boolean long options
+ *
+ * Names are packed into one character pool, values into a bitset, and lookups
+ * go through an open-addressing hash table of 32-bit slots, so each flag costs
+ * its name plus roughly 12 bytes instead of an Argument object and two map
+ * nodes. Lookup time does not depend on the number of flags.
+ */
+class FlagSet {
+ public:
+  /// Returned by add() and find() when no flag applies
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+ private:
+  std::string names_;                      // All names, back to back
+  std::vector<std::uint32_t> offsets_{0};  // Name i is [offsets_[i], [i + 1])
+  detail::BitVector bits_;                 // Bit i is set if flag i was given
+  std::vector<std::uint32_t> slots_;       // Flag index + 1, or 0 if empty
+
+  static std::size_t hash(std::string_view name) {
+    return static_cast<std::size_t>(detail::fnv1a(name));
+  }
+
+  void insertSlot(std::size_t index) {
+    const std::size_t mask = slots_.size() - 1;
+    std::size_t slot = hash(name(index)) & mask;
+    while (slots_[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = static_cast<std::uint32_t>(index + 1);
+  }
+
+  void rehash(std::size_t capacity) {
+    slots_.assign(capacity, 0);
+    for (std::size_t i = 0; i < size(); ++i) {
+      insertSlot(i);
+    }
+  }
+
+ public:
+  /**
+   * @brief Reserve room for a number of flags and their names
+   * @param count The expected number of flags
+   * @param nameBytes The expected total length of their names
+   */
+  void reserve(std::size_t count, std::size_t nameBytes) {
+    names_.reserve(nameBytes);
+    offsets_.reserve(count + 1);
+    bits_.reserve(count);
+    std::size_t capacity = slots_.empty() ? 16 : slots_.size();
+    while (capacity < count * 2) {
+      capacity *= 2;
+    }
+    if (capacity != slots_.size()) {
+      rehash(capacity);
+    }
+  }
+
+  /**
+   * @brief Add a flag
+   * @param name The long name, without the leading "--"
+   * @return std::size_t The flag's index, or npos if the name already exists
+   */
+  std::size_t add(std::string_view name) {
+    if (find(name) != npos) {
+      return npos;
+    }
+    const std::size_t index = size();
+    names_.append(name.data(), name.size());
+    offsets_.push_back(static_cast<std::uint32_t>(names_.size()));
+    bits_.pushBack(false);
+    // Keep the table at most half full
+    if (slots_.size() < (index + 1) * 2) {
+      rehash(slots_.empty() ? 16 : slots_.size() * 2);
+    } else {
+      insertSlot(index);
+    }
+    return index;
+  }
+
+  /**
+   * @brief Find a flag by name
+   * @param name The long name, without the leading "--"
+   * @return std::size_t The flag's index, or npos if there is none
+   */
+  [[nodiscard]] std::size_t find(std::string_view name) const {
+    if (slots_.empty()) {
+      return npos;
+    }
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t slot = hash(name) & mask; slots_[slot] != 0;
+         slot = (slot + 1) & mask) {
+      const std::size_t index = slots_[slot] - 1;
+      if (this->name(index) == name) {
+        return index;
+      }
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Get the number of flags
+   */
+  [[nodiscard]] std::size_t size() const { return offsets_.size() - 1; }
+
+  /**
+   * @brief Get the name of a flag
+   * @param index The flag's index
+   */
+  [[nodiscard]] std::string_view name(std::size_t index) const {
+    return std::string_view(names_).substr(
+        offsets_[index], offsets_[index + 1] - offsets_[index]);
+  }
+
+  /**
+   * @brief Check whether a flag was given
+   * @param index The flag's index
+   */
+  [[nodiscard]] bool test(std::size_t index) const {
+    return bits_.test(index);
+  }
+
+  /**
+   * @brief Mark a flag as given
+   * @param index The flag's index
+   */
+  void set(std::size_t index) { bits_.set(index); }
+
+  /**
+   * @brief Mark a flag as not given (e.g., --name=false)
+   * @param index The flag's index
+   */
+  void reset(std::size_t index) { bits_.reset(index); }
+
+  /**
+   * @brief Get the heap memory held by the flag set
+   * @return std::size_t The reserved bytes of the name pool, offsets, bitset
+   * and hash table
+   */
+  [[nodiscard]] std::size_t memoryUsage() const {
+    return names_.capacity() + offsets_.capacity() * sizeof(std::uint32_t) +
+           bits_.words().capacity() * sizeof(std::uint64_t) +
+           slots_.capacity() * sizeof(std::uint32_t);
+  }
+};
+
+class Parser;
+
+/**
+ * @brief A subcommand and the factory that registers its arguments
+ *
+ * Subcommands are described by a caller-owned table (typically a static
+ * array), so registering them costs no allocations. The factory only runs for
+ * the subcommand that actually appears on the command line.
+ */
+struct Subcommand {
+  const char* name;         ///< Name used on the command line (e.g., "commit")
+  const char* description;  ///< Description for help text
+  void (*registerArguments)(Parser& parser);  ///< Adds the subcommand's args
+};
+
+/**
+ * @brief Value type of an argument registered through a descriptor table
+ */
+enum class ArgumentType : std::uint8_t {
+  BOOL = 0,  ///< Argument<bool> (a flag)
+  STRING,    ///< Argument<std::string>
+  INT16,     ///< Argument<int16_t>
+  UINT32,    ///< Argument<uint32_t>
+  INT32,     ///< Argument<int32_t>
+  UINT64,    ///< Argument<uint64_t>
+  INT64,     ///< Argument<int64_t>
+  FLOAT,     ///< Argument<float>
+  DOUBLE     ///< Argument<double>
+};
+
+/**
+ * @brief One option in a table passed to Parser::addArguments()
+ *
+ * The strings are copied by default. With StringStorage::REFERENCE they must
+ * outlive the parser instead; string literals always do. The table itself
+ * may be a temporary.
+ */
+struct ArgumentDescriptor {
+  ArgumentType type;        ///< Value type of the option
+  const char* name;         ///< Long name (e.g., "count")
+  const char* shortName;    ///< Short name (e.g., "c"), or nullptr for none
+  const char* description;  ///< Description for help text
+  bool required;            ///< Whether the option must be given (not flags)
+  const char* defaultValue;  ///< Default in command-line syntax, or nullptr
+};
+
+namespace detail {
+
+/// First bytes of every frozen schema
+constexpr std::array<char, 8> kFrozenMagic{'A', 'R', 'G', 'S', 'S', 'C',
+                                           'H', 'M'};
+
+/// Layout version of frozen schemas; bump on any layout change
+constexpr std::uint32_t kFrozenVersion = 2;
+
+/**
+ * @brief A string in the frozen schema's pool
+ */
+struct FrozenString {
+  std::uint32_t offset{0};
+  std::uint32_t size{0};
+};
+
+/**
+ * @brief Fixed-size start of a frozen schema
+ *
+ * The blob is header, records (options, then positionals), the long name
+ * index, the short name index and the string pool, all in native byte order
+ * and addressed by offset, so it can be mapped at any address.
+ */
+struct FrozenHeader {
+  std::array<char, 8> magic{};
+  std::uint32_t version{0};
+  std::uint32_t optionCount{0};
+  std::uint32_t positionalCount{0};
+  std::uint32_t longIndexCount{0};
+  std::uint32_t shortIndexCount{0};
+  std::uint32_t stringBytes{0};
+  FrozenString help;
+  std::uint64_t hash{0};  // FNV-1a of everything after the header
+};
+
+/// Set in FrozenRecord::flags for options that must be given
+constexpr std::uint8_t kFrozenRequired = 1U;
+
+/**
+ * @brief One option or positional argument of a frozen schema
  */
-enum class ParseResult : std::uint8_t {
-  SUCCESS = 0,     ///< Parsing completed successfully
-  UNKNOWN_OPTION,  ///< An unknown option was provided
-  MISSING_VALUE,   ///< A required value is missing
-  INVALID_VALUE,   ///< A value is invalid (wrong type or failed validation)
-  HELP_REQUESTED   ///< Help was requested (-h or --help)
+struct FrozenRecord {
+  FrozenString name;
+  FrozenString shortName;
+  FrozenString description;
+  FrozenString defaultValue;  // Command-line syntax; empty for none
+  std::uint8_t type{0};
+  std::uint8_t flags{0};
+  std::uint16_t reserved{0};
 };
 
 /**
- * @brief Base class for all argument types
- *
- * This abstract class defines the interface for all argument types.
- * Each concrete argument type must implement these methods to handle
- * parsing, validation, and help display.
+ * @brief Entry of a frozen name index, sorted by name
  */
-class ArgumentBase {
- protected:
-  std::string name_;
-  std::string shortName_;
-  std::string description_;
-  bool isSet_{false};
-  bool isRequired_{false};
+struct FrozenIndexEntry {
+  FrozenString name;
+  std::uint32_t record{0};
+};
 
- public:
-  /**
-   * @brief Construct a new ArgumentBase object
-   *
-   * @param name The name of the argument
-   * @param shortName The short name of the argument
-   * @param description The description of the argument
-   * @param required Whether the argument is required
-   *
-   */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-  ArgumentBase(const std::string& name, const std::string& shortName,
-               const std::string& description, bool required)
-      : name_(name),
-        shortName_(shortName),
-        description_(description),
-        isRequired_(required) {}
+/**
+ * @brief Append the bytes of a trivially copyable value
+ */
+template <typename T>
+void appendBytes(std::string& out, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>, "must be trivially copyable");
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * @brief Read a trivially copyable value at any (unaligned) offset
+ */
+template <typename T>
+T loadBytes(const char* data, std::size_t offset) {
+  T value;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  std::memcpy(&value, data + offset, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief The ArgumentType tag of a value type
+ */
+template <typename T>
+struct ArgumentTypeOf;
+template <>
+struct ArgumentTypeOf<bool> {
+  static constexpr ArgumentType value = ArgumentType::BOOL;
+};
+template <>
+struct ArgumentTypeOf<std::string> {
+  static constexpr ArgumentType value = ArgumentType::STRING;
+};
+template <>
+struct ArgumentTypeOf<int16_t> {
+  static constexpr ArgumentType value = ArgumentType::INT16;
+};
+template <>
+struct ArgumentTypeOf<uint32_t> {
+  static constexpr ArgumentType value = ArgumentType::UINT32;
+};
+template <>
+struct ArgumentTypeOf<int32_t> {
+  static constexpr ArgumentType value = ArgumentType::INT32;
+};
+template <>
+struct ArgumentTypeOf<uint64_t> {
+  static constexpr ArgumentType value = ArgumentType::UINT64;
+};
+template <>
+struct ArgumentTypeOf<int64_t> {
+  static constexpr ArgumentType value = ArgumentType::INT64;
+};
+template <>
+struct ArgumentTypeOf<float> {
+  static constexpr ArgumentType value = ArgumentType::FLOAT;
+};
+template <>
+struct ArgumentTypeOf<double> {
+  static constexpr ArgumentType value = ArgumentType::DOUBLE;
+};
+
+/// Type code of value types without an ArgumentType tag
+constexpr std::uint8_t kUntypedArgument = 0xFF;
+
+/**
+ * @brief ArgumentTypeOf<T> as a byte, or kUntypedArgument
+ */
+template <typename T, typename = void>
+struct TypeCodeOf {
+  static constexpr std::uint8_t value = kUntypedArgument;
+};
+template <typename T>
+struct TypeCodeOf<T, std::void_t<decltype(ArgumentTypeOf<T>::value)>> {
+  static constexpr auto value =
+      static_cast<std::uint8_t>(ArgumentTypeOf<T>::value);
+};
 
+/**
+ * @brief Open-addressing hash index from names to registered arguments
+ *
+ * Filled at registration, so const lookups never write and may run
+ * concurrently. Entries keep the value type code, so a typed lookup needs no
+ * dynamic_cast.
+ */
+class NameTable {
+ public:
   /**
-   * @brief Virtual destructor for proper cleanup
+   * @brief One resolved name
    */
-  virtual ~ArgumentBase() = default;
+  struct Entry {
+    std::string_view name;
+    ArgumentBase* argument;
+    std::uint8_t type;  // TypeCodeOf<T> of the argument's value type
+    bool positional;
+  };
 
-  // Explicitly declare special member functions to comply with
-  // cppcoreguidelines-special-member-functions
+ private:
+  std::vector<Entry> entries_;
+  std::vector<std::uint32_t> slots_;  // Entry index + 1, or 0 if empty
+
+  [[nodiscard]] std::size_t findSlot(std::string_view name) const {
+    const std::size_t mask = slots_.size() - 1;
+    auto slot = static_cast<std::size_t>(fnv1a(name)) & mask;
+    while (slots_[slot] != 0 && entries_[slots_[slot] - 1].name != name) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void rehash(std::size_t capacity) {
+    slots_.assign(capacity, 0);
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+      slots_[findSlot(entries_[i].name)] = static_cast<std::uint32_t>(i + 1);
+    }
+  }
 
+ public:
   /**
-   * @brief Copy constructor (deleted)
+   * @brief Reserve room for a number of additional names
+   * @param count The number of names about to be inserted
    */
-  ArgumentBase(const ArgumentBase&) = delete;
+  void reserve(std::size_t count) {
+    const std::size_t needed = entries_.size() + count;
+    entries_.reserve(needed);
+    std::size_t capacity = std::max<std::size_t>(slots_.size(), 16);
+    while (capacity < needed * 2) {
+      capacity *= 2;
+    }
+    if (capacity != slots_.size()) {
+      rehash(capacity);
+    }
+  }
 
   /**
-   * @brief Copy assignment operator (deleted)
+   * @brief Add a name, following the lookup order of the name-based API
+   *
+   * An option replaces an earlier entry of the same name; a positional
+   * argument never replaces one.
+   * @param entry The entry to add
    */
-  ArgumentBase& operator=(const ArgumentBase&) = delete;
+  void insert(const Entry& entry) {
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+      rehash(std::max<std::size_t>(16, slots_.size() * 2));
+    }
+    const std::size_t slot = findSlot(entry.name);
+    if (slots_[slot] != 0) {
+      if (!entry.positional) {
+        entries_[slots_[slot] - 1] = entry;
+      }
+      return;
+    }
+    entries_.push_back(entry);
+    slots_[slot] = static_cast<std::uint32_t>(entries_.size());
+  }
 
   /**
-   * @brief Move constructor (deleted)
+   * @brief Look up a name
+   * @param name The long name of an option or the name of a positional
+   * @return const Entry* The entry, or nullptr if the name is unknown
    */
-  ArgumentBase(ArgumentBase&&) = delete;
+  [[nodiscard]] const Entry* find(std::string_view name) const {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+    const std::uint32_t index = slots_[findSlot(name)];
+    return index == 0 ? nullptr : &entries_[index - 1];
+  }
 
   /**
-   * @brief Move assignment operator (deleted)
+   * @brief Heap bytes held by the index
    */
-  ArgumentBase& operator=(ArgumentBase&&) = delete;
+  [[nodiscard]] std::size_t memoryUsage() const {
+    return entries_.capacity() * sizeof(Entry) +
+           slots_.capacity() * sizeof(std::uint32_t);
+  }
+};
+
+/**
+ * @brief One option split from argv by tokenizeArguments()
+ */
+struct OptionToken {
+  std::string_view word;   ///< The whole argv word (e.g., "--name=value")
+  std::string_view name;   ///< The name without dashes (e.g., "name")
+  std::string_view value;  ///< The value, if hasValue
+  int index{0};            ///< argv index of the word
+  int valueIndex{0};       ///< argv index of the value (index if inline)
+  bool isLong{false};      ///< Given with "--"
+  bool hasValue{false};    ///< A value was given inline or taken from argv
+
+  /// The dashes the option was given with, for error messages
+  [[nodiscard]] const char* dashes() const { return isLong ? "--" : "-"; }
+};
+
+/// Hidden option used by the generated shell completion scripts
+constexpr const char* kCompleteFlag = "--__complete";
+
+/**
+ * @brief Check argv for --help or -h before anything is parsed
+ *
+ * @param argc The number of command-line arguments
+ * @param argv The array of command-line argument strings
+ * @param isBoundary Ends the scan at a word that starts another parser's
+ * arguments; "--" always ends it
+ * @return true if help was asked for
+ */
+template <typename Boundary>
+bool helpRequested(int argc, char** argv, Boundary isBoundary) {
+  for (int i = 1; i < argc; ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const std::string_view arg{argv[i]};
+    if (arg == "--help" || arg == "-h") {
+      return true;
+    }
+    if (arg == "--" || isBoundary(arg)) {
+      break;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Token loop shared by Parser, FrozenSchema and parseGenerated()
+ *
+ * Splits argv into positional words, grouped short flags (-abc) and options
+ * with their values (--name value, --name=value, -n value, -nvalue); a bare
+ * "--" ends the options. The caller's hooks look names up and store values,
+ * returning SUCCESS to go on or the result that ends parsing.
+ * @tparam Hooks Provides Key, findShort(name), isFlag(key), takesValue(key)
+ * (both false for unknown keys), lookup(token, key), positional(index, word,
+ * optionsEnded), flag(token, key), store(token, key), unknown(token),
+ * missingValue(token) and done(), which stops the loop early
+ * @param argc The number of command-line arguments
+ * @param argv The array of command-line argument strings
+ * @param hooks The caller's lookups and stores
+ * @return ParseResult The first result other than SUCCESS, else SUCCESS
+ */ // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+template <typename Hooks>
+ParseResult tokenizeArguments(int argc, char** argv, Hooks& hooks) {
+  bool optionsEnded = false;  // After "--" every word is positional
+  for (int i = 1; i < argc && !hooks.done(); ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const std::string_view arg{argv[i]};
+    ARGSPARSER_STATISTICS_COUNT(tokens);
+
+    if (!optionsEnded && arg == "--") {
+      optionsEnded = true;
+      continue;
+    }
+    ParseResult result = ParseResult::SUCCESS;
+    if (optionsEnded || arg.empty() || arg[0] != '-') {
+      result = hooks.positional(i, arg, optionsEnded);
+      if (result != ParseResult::SUCCESS) {
+        return result;
+      }
+      continue;
+    }
+
+    OptionToken token;
+    token.word = arg;
+    token.index = i;
+    token.valueIndex = i;
+    token.isLong = arg.size() > 1 && arg[1] == '-';
+    {
+      ARGSPARSER_PARSE_STEP(TOKENIZE, i, arg);
+      if (token.isLong) {
+        token.name = arg.substr(2);
+        const std::size_t equalPos = token.name.find('=');
+        if (equalPos != std::string_view::npos) {
+          token.value = token.name.substr(equalPos + 1);
+          token.name = token.name.substr(0, equalPos);
+          token.hasValue = true;
+        }
+      } else if (arg.size() > 2 &&
+                 hooks.takesValue(hooks.findShort(arg.substr(1, 1)))) {
+        // -nvalue for an option with a value
+        token.name = arg.substr(1, 1);
+        token.value = arg.substr(2);
+        token.hasValue = true;
+      } else if (arg.size() > 2) {
+        // -abc if every character is a flag, else one short name
+        bool isGrouped = true;
+        for (std::size_t j = 1; j < arg.size() && isGrouped; ++j) {
+          isGrouped = hooks.isFlag(hooks.findShort(arg.substr(j, 1)));
+        }
+        if (isGrouped) {
+          for (std::size_t j = 1; j < arg.size(); ++j) {
+            OptionToken flag = token;
+            flag.name = arg.substr(j, 1);
+            result = hooks.flag(flag, hooks.findShort(flag.name));
+            if (result != ParseResult::SUCCESS) {
+              return result;
+            }
+          }
+          continue;
+        }
+        token.name = arg.substr(1);
+      } else {
+        token.name = arg.substr(1);
+      }
+    }
+
+    typename Hooks::Key key{};
+    result = hooks.lookup(token, key);
+    if (result != ParseResult::SUCCESS) {
+      return result;
+    }
+    if (hooks.isFlag(key)) {
+      result = hooks.flag(token, key);
+    } else if (!hooks.takesValue(key)) {
+      return hooks.unknown(token);
+    } else {
+      if (!token.hasValue) {
+        if (i + 1 >= argc) {
+          return hooks.missingValue(token);
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        token.value = argv[++i];
+        token.valueIndex = i;
+        token.hasValue = true;
+        ARGSPARSER_STATISTICS_COUNT(tokens);
+      }
+      result = hooks.store(token, key);
+    }
+    if (result != ParseResult::SUCCESS) {
+      return result;
+    }
+  }
+  return ParseResult::SUCCESS;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Main argument parser class
+ *
+ * The Parser class is the primary interface for defining and parsing
+ * command-line arguments. It manages a collection of arguments and
+ * handles the parsing of command-line input.
+ */
+class Parser {
+ private:
+  std::string programName_;
+  std::string description_;
+  std::vector<std::unique_ptr<ArgumentBase>> arguments_;
+  // Keys view the names owned (or referenced) by the arguments themselves
+  std::map<std::string_view, ArgumentBase*> longNameMap_;
+  std::map<std::string_view, ArgumentBase*> shortNameMap_;
+  std::map<std::string, ArgumentBase*, std::less<>> envNameMap_;
+  std::vector<std::unique_ptr<ArgumentBase>> positionalArguments_;
+  std::string lastError_;
+  ConfigError configError_;
+  const Subcommand* subcommands_{nullptr};
+  std::size_t subcommandCount_{0};
+  bool subcommandsSorted_{true};
+  std::vector<std::size_t> subcommandOrder_;
+  const Subcommand* activeSubcommand_{nullptr};
+  std::unique_ptr<Parser> subcommandParser_;
+  std::vector<ArgumentBase*> nameIndex_;
+  bool nameIndexDirty_{true};
+  detail::NameTable nameTable_;  // getValue() and isSet() by name
+  bool allowAbbreviations_{false};
+  bool completionEnabled_{false};
+  FlagSet packedFlags_;
 
   /**
-   * @brief Parse a string value into the argument's type
-   * @param value The string value to parse
-   * @return true if parsing was successful, false otherwise
+   * @brief Per-option metadata in parallel arrays, indexed like arguments_
+   *
+   * The parse loop, the required check and help read these packed arrays
+   * instead of visiting (or dynamic_cast-ing) each Argument object.
    */
-  virtual bool parse(const std::string& value) = 0;
+  struct OptionTable {
+    std::vector<std::string_view> names;       // Views of the long names
+    std::vector<std::string_view> shortNames;  // Views of the short names
+    detail::BitVector required;                // Options that must be given
+    detail::BitVector flags;                   // Boolean options (no value)
+    detail::BitVector set;                     // Options that received a value
+  };
+  OptionTable options_;
 
   /**
-   * @brief Print help information for this argument
-   * @param os The output stream to print to
+   * @brief Options constrained together, as a mask over the option table
    */
-  virtual void printHelp(std::ostream& os) const;
+  struct OptionGroup {
+    GroupKind kind;
+    detail::BitVector members;  // Bit i is set if option i is in the group
+    std::size_t size;           // Number of members
+  };
+  std::vector<OptionGroup> groups_;
 
   /**
-   * @brief Check if this argument has been set
-   * @return true if the argument was provided, false otherwise
+   * @brief Node of the BK-tree used for "did you mean" suggestions
    */
-  [[nodiscard]] bool isSet() const { return isSet_; }
+  struct SuggestionNode {
+    const ArgumentBase* argument;
+    /// (Levenshtein distance to this node, index of the child node)
+    std::vector<std::pair<std::size_t, std::size_t>> children;
+  };
+  std::vector<SuggestionNode> suggestionTree_;
+  bool suggestionTreeDirty_{true};
+  std::vector<std::size_t> suggestionRows_;     // editDistance() scratch
+  std::vector<std::size_t> suggestionPending_;  // BK-tree nodes to visit
+  int completionWordCount_{0};
+  char** completionWords_{nullptr};
+#if defined(ARGSPARSER_STATISTICS)
+  detail::StatisticsCounters statistics_;
+#endif
+
+  /// Longest "section.key" name accepted in a config file
+  static constexpr std::size_t kMaxConfigKeyLength = 256;
 
+ public:
   /**
-   * @brief Check if this argument is required
-   * @return true if the argument is required, false otherwise
-   */
-  [[nodiscard]] bool isRequired() const { return isRequired_; }
+   * @brief Construct a new Parser object
+   *
+   * @param programName The name of the program (used in help text)
+   * @param description A description of the program (used in help text)
+   */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters,hicpp-explicit-conversions)
+  Parser(const std::string& programName, const std::string& description = "")
+      : programName_(programName), description_(description) {}
 
   /**
-   * @brief Get the name of this argument
-   * @return The argument's name
+   * @brief Get the last error message
+   *
+   * @return const std::string& The last error message
    */
-  [[nodiscard]] const std::string& getName() const { return name_; }
+  [[nodiscard]] const std::string& getLastError() const { return lastError_; }
 
   /**
-   * @brief Get the short name of this argument
-   * @return The argument's short name
+   * @brief Get the location of the last config file error
+   *
+   * @return const ConfigError& The last config error (line and column are 0
+   * if the last config parse succeeded or failed before reading any line)
    */
-  [[nodiscard]] const std::string& getShortName() const { return shortName_; }
+  [[nodiscard]] const ConfigError& getLastConfigError() const {
+    return configError_;
+  }
 
+#if defined(ARGSPARSER_STATISTICS)
   /**
-   * @brief Get the description of this argument
-   * @return The argument's description
+   * @brief Get a snapshot of this parser's runtime statistics
+   *
+   * Counters are updated atomically, so the snapshot may be taken while
+   * another thread parses. Subcommand parsers keep their own statistics.
+   * @return ParseStatistics The counters accumulated since the last reset
    */
-  [[nodiscard]] const std::string& getDescription() const {
-    return description_;
+  [[nodiscard]] ParseStatistics stats() const {
+    return statistics_.snapshot();
   }
 
- protected:
   /**
-   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
-   * @return The type name or empty string if no type name should be displayed
+   * @brief Reset all runtime statistics to zero
    */
-  [[nodiscard]] virtual std::string getTypeName() const { return ""; }
+  void resetStats() { statistics_.reset(); }
+#endif
 
   /**
-   * @brief Get the default value as a string
-   * @return String representation of the default value or empty string if no
-   * default
+   * @brief Report the heap memory held by this parser's schema
+   *
+   * Covers the argument objects, owned strings, lookup maps, validators,
+   * positional slots, indexes and packed flags, plus the schema of an active
+   * subcommand. The Parser object itself is not included.
+   * @return MemoryUsage The footprint broken down by category
    */
-  [[nodiscard]] virtual std::string getDefaultString() const { return ""; }
+  [[nodiscard]] MemoryUsage memoryUsage() const {
+    using ArgumentSlot = std::unique_ptr<ArgumentBase>;
+    MemoryUsage usage;
+    for (const auto& argument : arguments_) {
+      argument->addMemoryUsage(usage);
+    }
+    for (const auto& argument : positionalArguments_) {
+      argument->addMemoryUsage(usage);
+    }
+    usage.strings += detail::heapBytes(programName_) +
+                     detail::heapBytes(description_) +
+                     detail::heapBytes(lastError_) +
+                     detail::heapBytes(configError_.message);
+
+    using NameNode = decltype(longNameMap_)::value_type;
+    usage.mapNodes += (longNameMap_.size() + shortNameMap_.size()) *
+                      detail::mapNodeBytes<NameNode>();
+    using EnvironmentNode = decltype(envNameMap_)::value_type;
+    usage.mapNodes += envNameMap_.size() *
+                      detail::mapNodeBytes<EnvironmentNode>();
+    for (const auto& entry : envNameMap_) {
+      usage.strings += detail::heapBytes(entry.first);
+    }
+
+    usage.positionalScratch +=
+        positionalArguments_.capacity() * sizeof(ArgumentSlot);
+
+    usage.indexes += arguments_.capacity() * sizeof(ArgumentSlot);
+    usage.indexes +=
+        (options_.names.capacity() + options_.shortNames.capacity()) *
+        sizeof(std::string_view);
+    usage.indexes += (options_.required.words().capacity() +
+                      options_.flags.words().capacity() +
+                      options_.set.words().capacity()) *
+                     sizeof(std::uint64_t);
+    usage.indexes += nameTable_.memoryUsage();
+    usage.indexes += groups_.capacity() * sizeof(OptionGroup);
+    for (const OptionGroup& group : groups_) {
+      usage.indexes += group.members.words().capacity() * sizeof(std::uint64_t);
+    }
+    usage.indexes += nameIndex_.capacity() * sizeof(ArgumentBase*) +
+                     subcommandOrder_.capacity() * sizeof(std::size_t) +
+                     suggestionTree_.capacity() * sizeof(SuggestionNode) +
+                     suggestionRows_.capacity() * sizeof(std::size_t) +
+                     suggestionPending_.capacity() * sizeof(std::size_t);
+    for (const SuggestionNode& node : suggestionTree_) {
+      usage.indexes += node.children.capacity() *
+                       sizeof(std::pair<std::size_t, std::size_t>);
+    }
+
+    usage.packedFlags += packedFlags_.memoryUsage();
+    if (subcommandParser_) {
+      usage.indexes += sizeof(Parser);
+      usage += subcommandParser_->memoryUsage();
+    }
+    return usage;
+  }
 
   /**
-   * @brief Check if the argument has a default value that should be displayed
-   * @return true if a default value should be shown, false otherwise
+   * @brief Add a new argument to the parser
+   *
+   * The strings are copied, so they may be temporaries.
+   * @tparam T The type of the argument (e.g., bool, std::string, int)
+   * @param name The long name of the argument (e.g., "verbose")
+   * @param shortName The short name of the argument (e.g., "v")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: T{})
+   * @return Argument<T>* Pointer to the created argument, or nullptr if
+   * the name is already a packed flag (see getLastError())
+   * @note The returned pointer is owned by the parser and should not be
+   * deleted.
    */
-  [[nodiscard]] virtual bool hasDefaultValue() const { return false; }
-};
+  template <typename T>
+  Argument<T>* addArgument(const std::string& name,
+                           const std::string& shortName,
+                           const std::string& description,
+                           bool required = false, const T& defaultValue = T{}) {
+    return addArgument<T>(name, shortName, description, required, defaultValue,
+                          StringStorage::COPY);
+  }
 
-/**
- * @brief Template class for typed arguments
- *
- * This template class provides the base implementation for arguments of any
- * type. Specializations exist for specific types like std::string, bool, and
- * int.
- * @tparam T The type of value this argument holds
- */
-template <typename T>
-class Argument : public ArgumentBase {
- public:
   /**
-   * @brief Validator function type
+   * @brief Add a new argument from C strings
    *
-   * A validator is a function that takes a value of type T and returns
-   * true if the value is valid, false otherwise.
+   * Chosen for calls such as addArgument<int>("count", "c", "Count"). The
+   * strings are copied straight into the argument's pooled buffer, without
+   * std::string temporaries, so they may point at temporaries too. Pass
+   * StringStorage::REFERENCE to the overload taking a storage mode to skip
+   * the copy for strings that outlive the parser, such as literals.
+   * @tparam T The type of the argument (e.g., bool, std::string, int)
+   * @param name The long name of the argument (e.g., "verbose")
+   * @param shortName The short name of the argument (e.g., "v")
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: false)
+   * @param defaultValue The default value for this argument (default: T{})
+   * @return Argument<T>* Pointer to the created argument, or nullptr if
+   * the name is already a packed flag (see getLastError())
    */
-  using Validator = std::function<bool(const T&)>;
-
- protected:
-  T value_;
-  Validator validator_;
+  template <typename T>
+  Argument<T>* addArgument(const char* name, const char* shortName,
+                           const char* description, bool required = false,
+                           const T& defaultValue = T{}) {
+    return addArgument<T>(name, shortName, description, required, defaultValue,
+                          StringStorage::COPY);
+  }
 
- public:
   /**
-   * @brief Construct a new Argument object
+   * @brief Add a new argument, choosing how its strings are stored
    *
+   * @tparam T The type of the argument (e.g., bool, std::string, int)
    * @param name The long name of the argument (e.g., "verbose")
    * @param shortName The short name of the argument (e.g., "v")
    * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
+   * @param required Whether this argument is required
+   * @param defaultValue The default value for this argument
+   * @param storage COPY to keep owned copies, REFERENCE to point at storage
+   * that outlives the parser
+   * @return Argument<T>* Pointer to the created argument, or nullptr if
+   * the name is already a packed flag (see getLastError())
+   */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+  template <typename T>
+  Argument<T>* addArgument(std::string_view name, std::string_view shortName,
+                           std::string_view description, bool required,
+                           const T& defaultValue, StringStorage storage) {
+    ARGSPARSER_ALLOCATION_PHASE(REGISTRATION);
+    if (packedFlags_.find(name) != FlagSet::npos) {
+      lastError_ = "Duplicate option: --";
+      lastError_ += name;
+      return nullptr;
+    }
+    auto arg = std::make_unique<Argument<T>>(std::string_view(),
+                                             std::string_view(),
+                                             std::string_view(), required,
+                                             defaultValue);
+    arg->setStrings(name, shortName, description, storage);
+    Argument<T>* ptr = arg.get();
+
+    longNameMap_[ptr->getNameView()] = ptr;
+    shortNameMap_[ptr->getShortNameView()] = ptr;
+    nameTable_.insert(
+        {ptr->getNameView(), ptr, detail::TypeCodeOf<T>::value, false});
+    registerOption(ptr, std::is_same_v<T, bool>);
+    arguments_.push_back(std::move(arg));
+    nameIndexDirty_ = true;
+    suggestionTreeDirty_ = true;
+
+    return ptr;
+  }
+
+  /**
+   * @brief Add a new positional argument to the parser
+   *
+   * The strings are copied, so they may be temporaries.
+   * @tparam T The type of the argument (e.g., std::string, int)
+   * @param name The name of the positional argument
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: true)
    * @param defaultValue The default value for this argument (default: T{})
+   * @return Argument<T>* Pointer to the created argument
    */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool required = false,
-           const T& defaultValue = T{})
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {}
+  template <typename T>
+  Argument<T>*
+  addPositionalArgument(const std::string& name, const std::string& description,
+                        bool required = true, const T& defaultValue = T{}) {
+    return addPositionalArgument<T>(name, description, required, defaultValue,
+                                    StringStorage::COPY);
+  }
 
   /**
-   * @brief Set a validator function for this argument
+   * @brief Add a new positional argument from C strings
    *
-   * The validator function will be called during parsing to validate the value.
-   * @param validator The validator function to use
+   * The strings are copied, so they may point at temporaries (see the
+   * const char* overload of addArgument()).
+   * @tparam T The type of the argument (e.g., std::string, int)
+   * @param name The name of the positional argument
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required (default: true)
+   * @param defaultValue The default value for this argument (default: T{})
+   * @return Argument<T>* Pointer to the created argument
    */
-  void setValidator(const Validator& validator) { validator_ = validator; }
+  template <typename T>
+  Argument<T>* addPositionalArgument(const char* name, const char* description,
+                                     bool required = true,
+                                     const T& defaultValue = T{}) {
+    return addPositionalArgument<T>(name, description, required, defaultValue,
+                                    StringStorage::COPY);
+  }
 
   /**
-   * @brief Parse a string value into this argument's type
+   * @brief Add a new positional argument, choosing how its strings are stored
    *
-   * @param value The string value to parse
-   * @return true if parsing and validation were successful, false otherwise
-   */
-  bool parse(const std::string& value) override {
-    if (!parseValue(value)) {
-      return false;
+   * @tparam T The type of the argument (e.g., std::string, int)
+   * @param name The name of the positional argument
+   * @param description A description of the argument for help text
+   * @param required Whether this argument is required
+   * @param defaultValue The default value for this argument
+   * @param storage COPY to keep owned copies, REFERENCE to point at storage
+   * that outlives the parser
+   * @return Argument<T>* Pointer to the created argument
+   */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+  template <typename T>
+  Argument<T>* addPositionalArgument(std::string_view name,
+                                     std::string_view description,
+                                     bool required, const T& defaultValue,
+                                     StringStorage storage) {
+    ARGSPARSER_ALLOCATION_PHASE(REGISTRATION);
+    auto arg = std::make_unique<Argument<T>>(std::string_view(),
+                                             std::string_view(),
+                                             std::string_view(), required,
+                                             defaultValue);
+    arg->setStrings(name, std::string_view(), description, storage);
+    Argument<T>* ptr = arg.get();
+    nameTable_.insert(
+        {ptr->getNameView(), ptr, detail::TypeCodeOf<T>::value, true});
+    positionalArguments_.push_back(std::move(arg));
+    return ptr;
+  }
+
+  /**
+   * @brief Register options in bulk from a descriptor table
+   *
+   * The argument list is grown with one sized allocation, names are sorted
+   * once to find duplicates (within the table and against options already
+   * registered), and the sorted names are inserted into the lookup maps with
+   * position hints. Either every option is registered or, on error, none is.
+   * @param table Pointer to the first descriptor
+   * @param count The number of descriptors
+   * @param storage Whether the descriptor strings are copied (default) or
+   * referenced
+   * @return true on success; false if a name is empty or duplicated or a
+   * default value does not convert, with the reason in getLastError()
+   */ // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  bool addArguments(const ArgumentDescriptor* table, std::size_t count,
+                    StringStorage storage = StringStorage::COPY) {
+    ARGSPARSER_ALLOCATION_PHASE(REGISTRATION);
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto shortNameOf = [table](std::size_t i) {
+      return std::string_view(table[i].shortName != nullptr ? table[i].shortName
+                                                            : "");
+    };
+
+    // Sort once by long name, then by short name, to find duplicates
+    std::vector<detail::SortEntry> byName(count);
+    std::vector<detail::SortEntry> byShortName;
+    for (std::size_t i = 0; i < count; ++i) {
+      byName[i] = detail::SortEntry(table[i].name, i);
+      if (!shortNameOf(i).empty()) {
+        byShortName.emplace_back(shortNameOf(i), i);
+      }
+    }
+    std::sort(byName.begin(), byName.end());
+    std::sort(byShortName.begin(), byShortName.end());
+    for (std::size_t i = 0; i < byName.size(); ++i) {
+      const std::string_view name = byName[i].name;
+      if (name.empty()) {
+        lastError_ = "Empty option name in descriptor table";
+        return false;
+      }
+      if ((i > 0 && name == byName[i - 1].name) ||
+          longNameMap_.find(name) != longNameMap_.end() ||
+          packedFlags_.find(name) != FlagSet::npos) {
+        lastError_ = "Duplicate option: --";
+        lastError_ += name;
+        return false;
+      }
+    }
+    for (std::size_t i = 0; i < byShortName.size(); ++i) {
+      const std::string_view shortName = byShortName[i].name;
+      if ((i > 0 && shortName == byShortName[i - 1].name) ||
+          shortNameMap_.find(shortName) != shortNameMap_.end()) {
+        lastError_ = "Duplicate option: -";
+        lastError_ += shortName;
+        return false;
+      }
     }
 
-    if (validator_ && !validator_(value_)) {
-      return false;
+    // Build the arguments and convert their defaults before committing
+    std::vector<std::unique_ptr<ArgumentBase>> created;
+    created.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      created.push_back(makeArgument(table[i], shortNameOf(i), storage));
+      if (table[i].defaultValue != nullptr &&
+          !created.back()->parseView(table[i].defaultValue)) {
+        lastError_ = std::string("Invalid default for option: --") +
+                     table[i].name + " = " + table[i].defaultValue;
+        return false;
+      }
+      created.back()->clearSet();
     }
 
-    isSet_ = true;
+    // Index in sorted order, so each insertion lands next to its hint
+    auto longHint = longNameMap_.end();
+    for (const detail::SortEntry& entry : byName) {
+      ArgumentBase* argument = created[entry.index].get();
+      longHint = std::next(longNameMap_.emplace_hint(
+          longHint, argument->getNameView(), argument));
+    }
+    auto shortHint = shortNameMap_.end();
+    for (const detail::SortEntry& entry : byShortName) {
+      ArgumentBase* argument = created[entry.index].get();
+      shortHint = std::next(shortNameMap_.emplace_hint(
+          shortHint, argument->getShortNameView(), argument));
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    arguments_.reserve(arguments_.size() + count);
+    nameTable_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      ArgumentBase* argument = created[i].get();
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      nameTable_.insert({argument->getNameView(), argument,
+                         static_cast<std::uint8_t>(table[i].type), false});
+      registerOption(argument, table[i].type == ArgumentType::BOOL);
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      arguments_.push_back(std::move(created[i]));
+    }
+    nameIndexDirty_ = true;
+    suggestionTreeDirty_ = true;
     return true;
   }
 
   /**
-   * @brief Get the parsed value of this argument
-   *
-   * @return const T& The parsed value
+   * @brief Register options in bulk from a descriptor array
+   * @tparam N The number of descriptors
+   * @param table The descriptor array
+   * @param storage Whether the descriptor strings are copied (default) or
+   * referenced
+   * @return true on success, false otherwise (see getLastError())
+   * @see addArguments(const ArgumentDescriptor*, std::size_t, StringStorage)
    */
-  const T& getValue() const { return value_; }
+  template <std::size_t N>
+  bool addArguments(const ArgumentDescriptor (&table)[N],
+                    StringStorage storage = StringStorage::COPY) {
+    return addArguments(static_cast<const ArgumentDescriptor*>(table), N,
+                        storage);
+  }
 
- private:
   /**
-   * @brief Parse a string value into this argument's type (pure virtual)
+   * @brief Add a boolean long option stored in the packed flag set
    *
-   * This method must be implemented by specializations to handle
-   * type-specific parsing.
-   * @param value The string value to parse
-   * @return true if parsing was successful, false otherwise
+   * Meant for schemas with thousands of generated flags (e.g.,
+   * --feature-*): no Argument object or map node is created, the value is a
+   * single bit and lookup is a hash probe. Packed flags have no short name or
+   * description, and are not offered for abbreviations, suggestions or shell
+   * completion.
+   * @param name The long name of the flag (without "--")
+   * @return std::size_t The flag's index for isPackedFlagSet(), or
+   * FlagSet::npos if the name is empty, contains '=' or is already
+   * registered (see getLastError())
    */
-  virtual bool parseValue(const std::string& value) = 0;
-};
+  std::size_t addPackedFlag(std::string_view name) {
+    ARGSPARSER_ALLOCATION_PHASE(REGISTRATION);
+    if (name.empty() || name.find('=') != std::string_view::npos) {
+      lastError_ = "Invalid packed flag name: ";
+      lastError_ += name;
+      return FlagSet::npos;
+    }
+    if (longNameMap_.find(name) != longNameMap_.end() ||
+        packedFlags_.find(name) != FlagSet::npos) {
+      lastError_ = "Duplicate option: --";
+      lastError_ += name;
+      return FlagSet::npos;
+    }
+    return packedFlags_.add(name);
+  }
 
-/**
- * @brief Specialization for string arguments
- *
- * This specialization handles string arguments, which don't require
- * type conversion during parsing.
- */
-template <>
-class Argument<std::string> : public ArgumentBase {
- public:
   /**
-   * @brief Validator function type for string arguments
-   *
-   * A validator is a function that takes a string value and returns
-   * true if the value is valid, false otherwise.
+   * @brief Reserve room for packed flags before adding them
+   * @param count The expected number of packed flags
+   * @param nameBytes The expected total length of their names
    */
-  using Validator = std::function<bool(const std::string&)>;
-
- private:
-  std::string value_;
-  Validator validator_;
+  void reservePackedFlags(std::size_t count, std::size_t nameBytes) {
+    ARGSPARSER_ALLOCATION_PHASE(REGISTRATION);
+    packedFlags_.reserve(count, nameBytes);
+  }
 
- public:
   /**
-   * @brief Construct a new Argument object for string values
-   *
-   * @param name The long name of the argument (e.g., "input")
-   * @param shortName The short name of the argument (e.g., "i")
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
-   * @param defaultValue The default value for this argument (default: "")
+   * @brief Check whether a packed flag was given
+   * @param index The index returned by addPackedFlag()
+   * @return true if the flag was provided, false otherwise
    */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool required = false,
-           const std::string& defaultValue = "")
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {}
+  [[nodiscard]] bool isPackedFlagSet(std::size_t index) const {
+    return packedFlags_.test(index);
+  }
 
   /**
-   * @brief Set a validator function for this argument
-   *
-   * The validator function will be called during parsing to validate the value.
-   * @param validator The validator function to use
+   * @brief Get the packed flag set (e.g., to report its memory usage)
    */
-  void setValidator(const Validator& validator) { validator_ = validator; }
+  [[nodiscard]] const FlagSet& getPackedFlags() const { return packedFlags_; }
 
   /**
-   * @brief Parse a string value for this argument
+   * @brief Register the subcommands of a multi-command program
    *
-   * For string arguments, parsing is trivial - we just assign the value.
-   * @param value The string value to parse
-   * @return true if validation was successful, false otherwise
+   * The table is not copied and must outlive the parser. If it is sorted by
+   * name, lookups binary-search it directly; otherwise a sorted index is
+   * built on the first lookup. No subcommand's arguments are registered until
+   * parse() sees its name.
+   * @tparam N The number of subcommands
+   * @param table The subcommand table
    */
-  bool parse(const std::string& value) override {
-    if (validator_ && !validator_(value)) {
-      return false;
-    }
-
-    value_ = value;
-    isSet_ = true;
-    return true;
+  template <std::size_t N>
+  void setSubcommands(const Subcommand (&table)[N]) {
+    setSubcommands(static_cast<const Subcommand*>(table), N);
   }
 
   /**
-   * @brief Get the parsed value of this argument
+   * @brief Register the subcommands of a multi-command program
    *
-   * @return const std::string& The parsed value
+   * @param table Pointer to the first entry of the subcommand table
+   * @param count The number of entries in the table
+   * @see setSubcommands(const Subcommand (&)[N])
    */
-  [[nodiscard]] const std::string& getValue() const { return value_; }
+  void setSubcommands(const Subcommand* table, std::size_t count) {
+    ARGSPARSER_ALLOCATION_PHASE(REGISTRATION);
+    subcommands_ = table;
+    subcommandCount_ = count;
+    subcommandOrder_.clear();
+    activeSubcommand_ = nullptr;
+    subcommandParser_.reset();
+    subcommandsSorted_ = true;
+    for (std::size_t i = 1; i < count; ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      if (std::strcmp(table[i - 1].name, table[i].name) > 0) {
+        subcommandsSorted_ = false;
+        break;
+      }
+    }
+  }
 
- protected:
   /**
-   * @brief Get the default value as a string
-   * @return String representation of the default value or empty string if no
-   * default
+   * @brief Get the subcommand selected by the last parse()
+   * @return The selected table entry, or nullptr if none was given
    */
-  [[nodiscard]] std::string getDefaultString() const override { return value_; }
+  [[nodiscard]] const Subcommand* getSubcommand() const {
+    return activeSubcommand_;
+  }
 
   /**
-   * @brief Check if the argument has a default value that should be displayed
-   * @return true if a default value should be shown, false otherwise
+   * @brief Get the parser holding the selected subcommand's arguments
+   *
+   * @return Parser* The subcommand parser, or nullptr if no subcommand was
+   * given
+   * @note Use it to read the subcommand's values or to print its help when
+   * parse() returns HELP_REQUESTED.
    */
-  [[nodiscard]] bool hasDefaultValue() const override {
-    return !value_.empty();
+  [[nodiscard]] Parser* getSubcommandParser() {
+    return subcommandParser_.get();
   }
-};
-
-/**
- * @brief Specialization for boolean arguments (flags)
- *
- * This specialization handles boolean arguments, which are treated as flags.
- * Flags don't take values; their presence sets them to true.
- */
-template <>
-class Argument<bool> : public ArgumentBase {
- private:
-  bool value_;
 
- public:
   /**
-   * @brief Construct a new Argument object for boolean values (flags)
+   * @brief Accept unambiguous prefixes of long options (e.g., --verb)
    *
-   * @param name The long name of the argument (e.g., "verbose")
-   * @param shortName The short name of the argument (e.g., "v")
-   * @param description Description of the argument
-   * @param defaultValue Default value for the argument
-   * @param required Whether the argument is required (not typically used for
-   * flags)
+   * Exact names are always matched first. Otherwise the prefix is resolved
+   * through the sorted long-name index: the first name at or after the prefix
+   * is the only candidate, and the option is ambiguous if the following name
+   * shares the prefix too.
+   * @param allow Whether abbreviations are accepted (default: off)
    */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool defaultValue,
-           [[maybe_unused]] bool required)
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {
-    // Flags are never required
-    isRequired_ = false;
-  }
+  void setAllowAbbreviations(bool allow) { allowAbbreviations_ = allow; }
 
   /**
-   * @brief Parse a value for this boolean argument (flags)
+   * @brief Answer shell completion queries (`prog --__complete ...`)
    *
-   * @param value The value to parse (ignored for boolean flags)
-   * @return true Always returns true for boolean flags
+   * When enabled, parse() returns COMPLETION_REQUESTED if the first argument
+   * is `--__complete`; otherwise that word is an ordinary unknown option.
+   * @param enable Whether completion queries are answered (default: off)
    */
-  bool parse([[maybe_unused]] const std::string& value) override {
-    // For flags, we just set to true when present
-    value_ = true;
-    isSet_ = true;
-    return true;
-  }
+  void enableCompletion(bool enable = true) { completionEnabled_ = enable; }
 
   /**
-   * @brief Get the parsed value of this argument
+   * @brief Bind an environment variable to an option argument
    *
-   * @return bool The parsed value (true if flag was present)
-   */
-  [[nodiscard]] bool getValue() const { return value_; }
+   * When the option is not given on the command line, its value is taken from
+   * the variable (if present in the environment) during parse().
+   * @param name The long name of the option (e.g., "threads")
+   * @param variable The environment variable name (e.g., "MYAPP_THREADS")
+   * @return true if the binding was added, false if the option is unknown
+   */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+  bool bindEnvironmentVariable(const std::string& name,
+                               const std::string& variable) {
+    ARGSPARSER_ALLOCATION_PHASE(REGISTRATION);
+    auto it = longNameMap_.find(name);
+    if (it == longNameMap_.end() || variable.empty()) {
+      return false;
+    }
+    ArgumentBase* argument = it->second;
+    if (!argument->getEnvironmentVariable().empty()) {
+      envNameMap_.erase(argument->getEnvironmentVariable());
+    }
+    argument->setEnvironmentVariable(variable);
+    envNameMap_[variable] = argument;
+    return true;
+  }
 
- protected:
   /**
-   * @brief Get the default value as a string
-   * @return String representation of the default value or empty string if no
-   * default
+   * @brief Constrain which options of a group may be given together
+   *
+   * The group is stored as a bitmask over the option table. parse() checks
+   * it after the required options by ANDing the mask with the set-state
+   * bitset and counting bits, 64 options per step; values from the
+   * environment and config files count as given.
+   * @param kind The constraint
+   * @param names The long names of at least two options
+   * @return true if the group was added; false if a name is unknown or
+   * repeated, or fewer than two names were given, with the reason in
+   * getLastError()
    */
-  [[nodiscard]] std::string getDefaultString() const override {
-    return value_ ? "true" : "";
+  bool addOptionGroup(GroupKind kind,
+                      std::initializer_list<std::string_view> names) {
+    ARGSPARSER_ALLOCATION_PHASE(REGISTRATION);
+    if (names.size() < 2) {
+      lastError_ = "An option group needs at least two options";
+      return false;
+    }
+    OptionGroup group{kind, detail::BitVector(), names.size()};
+    group.members.reserve(options_.names.size());
+    for (std::size_t i = 0; i < options_.names.size(); ++i) {
+      group.members.pushBack(false);
+    }
+    for (const std::string_view name : names) {
+      const auto it = longNameMap_.find(name);
+      if (it == longNameMap_.end()) {
+        lastError_ = "Unknown option in group: --";
+        lastError_ += name;
+        return false;
+      }
+      const std::size_t index = it->second->getIndex();
+      if (group.members.test(index)) {
+        lastError_ = "Duplicate option in group: --";
+        lastError_ += name;
+        return false;
+      }
+      group.members.set(index);
+    }
+    groups_.push_back(std::move(group));
+    return true;
   }
 
   /**
-   * @brief Check if the argument has a default value that should be displayed
-   * @return true if a default value should be shown, false otherwise
+   * @brief Read option values from a key=value / INI config file
+   *
+   * The file is memory-mapped and tokenized in place. Each key is the long
+   * name of an option; keys inside a `[section]` are looked up as
+   * "section.key". Lines starting with '#' or ';' are comments, and values may
+   * be wrapped in double quotes. Values are parsed exactly like command-line
+   * values, and precedence is defaults < file < environment < argv, so the
+   * file may be read before or after parse().
+   * @param path The path of the config file
+   * @return ParseResult SUCCESS, UNKNOWN_OPTION for unknown keys, or
+   * INVALID_VALUE for unreadable files, syntax errors and bad values; see
+   * getLastConfigError() for the location
    */
-  [[nodiscard]] bool hasDefaultValue() const override { return value_; }
-};
+  ParseResult parseConfigFile(const std::string& path) {
+    ARGSPARSER_ALLOCATION_PHASE(PARSE);
+    const detail::MappedFile file(path.c_str());
+    if (!file.isOpen()) {
+      configError_ = ConfigError{0, 0, "cannot open config file"};
+      lastError_ = path + ": " + configError_.message;
+      return ParseResult::INVALID_VALUE;
+    }
+    return parseConfig(file.contents(), path);
+  }
 
-/**
- * @brief Specialization for 16-bit integer arguments
- *
- * This specialization handles 16-bit integer arguments, which require
- * conversion from string to int16_t during parsing.
- */
-template <>
-class Argument<int16_t> : public ArgumentBase {
- public:
   /**
-   * @brief Validator function type for 16-bit integer arguments
+   * @brief Read option values from key=value / INI formatted text
    *
-   * A validator is a function that takes an int16_t value and returns
-   * true if the value is valid, false otherwise.
-   */
-  using Validator = std::function<bool(int16_t)>;
+   * Same format and precedence as parseConfigFile(). The text is tokenized in
+   * place; no memory is allocated per line.
+   * @param contents The config text
+   * @param sourceName Name used as the prefix of error messages
+   * @return ParseResult The result of the parsing operation
+   */ // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  ParseResult parseConfig(std::string_view contents,
+                          std::string_view sourceName = "config") {
+    ARGSPARSER_ALLOCATION_PHASE(PARSE);
+    lastError_.clear();
+    configError_ = ConfigError{};
+
+    // Holds "section." followed by the current key
+    std::array<char, kMaxConfigKeyLength> keyBuffer{};
+    std::size_t sectionLength = 0;
+
+    constexpr std::string_view byteOrderMark = "\xEF\xBB\xBF";
+    if (contents.substr(0, byteOrderMark.size()) == byteOrderMark) {
+      contents.remove_prefix(byteOrderMark.size());
+    }
+
+    std::size_t lineNumber = 0;
+    while (!contents.empty()) {
+      ++lineNumber;
+      const std::size_t newline = contents.find('\n');
+      std::string_view line = contents.substr(0, newline);
+      contents.remove_prefix(newline == std::string_view::npos ? contents.size()
+                                                               : newline + 1);
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+
+      std::size_t start = 0;
+      while (start < line.size() && detail::isBlank(line[start])) {
+        ++start;
+      }
+      if (start == line.size() || line[start] == '#' || line[start] == ';') {
+        continue;
+      }
+
+      // [section]
+      if (line[start] == '[') {
+        const std::size_t close = line.find(']', start);
+        if (close == std::string_view::npos) {
+          return configFailure(sourceName, lineNumber, start + 1,
+                               "unterminated section header");
+        }
+        if (!isTrailingComment(line.substr(close + 1))) {
+          return configFailure(sourceName, lineNumber, close + 2,
+                               "unexpected text after section header");
+        }
+        const std::string_view section =
+            detail::trimBlanks(line.substr(start + 1, close - start - 1));
+        if (section.size() + 1 >= keyBuffer.size()) {
+          return configFailure(sourceName, lineNumber, start + 2,
+                               "section name too long");
+        }
+        section.copy(keyBuffer.data(), section.size());
+        keyBuffer[section.size()] = '.';
+        sectionLength = section.empty() ? 0 : section.size() + 1;
+        continue;
+      }
+
+      // key = value
+      const std::size_t equal = line.find('=', start);
+      if (equal == std::string_view::npos) {
+        return configFailure(sourceName, lineNumber, line.size() + 1,
+                             "expected '=' after key");
+      }
+      const std::string_view key =
+          detail::trimBlanks(line.substr(start, equal - start));
+      if (key.empty()) {
+        return configFailure(sourceName, lineNumber, equal + 1,
+                             "missing key before '='");
+      }
+
+      std::size_t valueColumn = equal + 1;
+      while (valueColumn < line.size() && detail::isBlank(line[valueColumn])) {
+        ++valueColumn;
+      }
+      std::string_view value = detail::trimBlanks(line.substr(equal + 1));
+      if (!value.empty() && value.front() == '"') {
+        const std::size_t closeQuote = value.find('"', 1);
+        if (closeQuote == std::string_view::npos) {
+          return configFailure(sourceName, lineNumber, valueColumn + 1,
+                               "unterminated quoted value");
+        }
+        if (!isTrailingComment(value.substr(closeQuote + 1))) {
+          return configFailure(sourceName, lineNumber,
+                               valueColumn + closeQuote + 2,
+                               "unexpected text after quoted value");
+        }
+        value = value.substr(1, closeQuote - 1);
+        ++valueColumn;
+      }
 
- private:
-  int16_t value_;
-  Validator validator_;
+      if (sectionLength + key.size() > keyBuffer.size()) {
+        return configFailure(sourceName, lineNumber, start + 1,
+                             "key too long");
+      }
+      key.copy(keyBuffer.data() + sectionLength, key.size());
+      const std::string_view fullKey(keyBuffer.data(),
+                                     sectionLength + key.size());
+
+      auto it = longNameMap_.find(fullKey);
+      if (it == longNameMap_.end()) {
+        configFailure(sourceName, lineNumber, start + 1,
+                      "unknown option '" + std::string(fullKey) + "'");
+        return ParseResult::UNKNOWN_OPTION;
+      }
+      ArgumentBase* argument = it->second;
+      if (argument->getSource() > ValueSource::CONFIG_FILE) {
+        continue;
+      }
+      if (!argument->parseView(value)) {
+        return configFailure(sourceName, lineNumber, valueColumn + 1,
+                             "invalid value for option '" +
+                                 std::string(fullKey) + "'");
+      }
+      markSet(argument, ValueSource::CONFIG_FILE);
+    }
 
- public:
-  /**
-   * @brief Construct a new Argument object for 16-bit integer values
-   *
-   * @param name The long name of the argument (e.g., "count")
-   * @param shortName The short name of the argument (e.g., "c")
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
-   * @param defaultValue The default value for this argument (default: 0)
-   */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool required = false,
-           int16_t defaultValue = 0)
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {}
+    return ParseResult::SUCCESS;
+  }
 
   /**
-   * @brief Set a validator function for this argument
+   * @brief Parse command-line arguments
    *
-   * The validator function will be called during parsing to validate the value.
-   * @param validator The validator function to use
+   * @param argc The number of command-line arguments
+   * @param argv The array of command-line argument strings
+   * @return ParseResult The result of the parsing operation
+   * @note Supports both long options (--) and short options (-), including
+   * grouped short options (-abc) and options with values (--option=value or
+   * -ovalue). A bare "--" ends the options: every later word is positional.
+   * Bound environment variables are read from the process environment.
    */
-  void setValidator(const Validator& validator) { validator_ = validator; }
+  ParseResult parse(int argc, char** argv) {
+    return parse(argc, argv, ARGSPARSER_ENVIRON);
+  }
 
   /**
-   * @brief Parse a string value into a 16-bit integer
+   * @brief Parse command-line arguments with an explicit environment
    *
-   * @param value The string value to parse
-   * @return true if parsing and validation were successful, false otherwise
-   */
-  bool parse(const std::string& value) override {
-    char* end = nullptr;
-    errno = 0;  // Reset errno before calling strtol
-    constexpr auto radix = 10;
-    const long parsedValue = std::strtol(value.c_str(), &end, radix);
+   * @param argc The number of command-line arguments
+   * @param argv The array of command-line argument strings
+   * @param envp A null-terminated array of "NAME=value" strings (as in
+   * `environ`), or nullptr to ignore environment bindings
+   * @return ParseResult The result of the parsing operation
+   * @note Values given in argv take precedence over environment variables.
+   */ // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  ParseResult parse(int argc, char** argv, char** envp) {
+    ARGSPARSER_ALLOCATION_PHASE(PARSE);
+#if defined(ARGSPARSER_STATISTICS)
+    const detail::ParseStatisticsScope statisticsScope(statistics_);
+#endif
 
-    // Check if the entire string was consumed
-    if (*end != '\0') {
-      return false;
+    // Clear the last error
+    lastError_.clear();
+
+    activeSubcommand_ = nullptr;
+    subcommandParser_.reset();
+
+    // Shell completion query: prog --__complete [words...] <partial>
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (completionEnabled_ && argc >= 2 &&
+        std::strcmp(argv[1], detail::kCompleteFlag) == 0) {
+      completionWordCount_ = argc - 2;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      completionWords_ = argv + 2;
+      return ParseResult::COMPLETION_REQUESTED;
     }
 
-    // Check for overflow/underflow
-    if (errno == ERANGE || parsedValue > INT16_MAX || parsedValue < INT16_MIN) {
-      return false;
+    // Check for help flag first (up to the subcommand, which has its own)
+    if (detail::helpRequested(argc, argv, [this](std::string_view arg) {
+          return findSubcommand(arg) != nullptr;
+        })) {
+      return ParseResult::HELP_REQUESTED;
     }
 
-    value_ = static_cast<int16_t>(parsedValue);
+    CommandLineHooks hooks{*this};
+    const ParseResult tokenResult =
+        detail::tokenizeArguments(argc, argv, hooks);
+    if (tokenResult != ParseResult::SUCCESS) {
+      return tokenResult;
+    }
+    const std::size_t positionalCount = hooks.positionalCount;
+    const int subcommandIndex = hooks.subcommandIndex;
+
+    // Fall back to bound environment variables for options not given in argv
+    if (envp != nullptr && !envNameMap_.empty()) {
+      const ParseResult envResult = parseEnvironment(envp);
+      if (envResult != ParseResult::SUCCESS) {
+        return envResult;
+      }
+    }
 
-    if (validator_ && !validator_(value_)) {
-      return false;
+    {
+      ARGSPARSER_PARSE_STEP(REQUIRED_CHECK, -1, std::string_view());
+
+      // Check required positional arguments that received no value
+      for (size_t index = positionalCount; index < positionalArguments_.size();
+           ++index) {
+        if (positionalArguments_[index]->isRequired()) {
+          lastError_ = "Missing required positional argument: ";
+          lastError_ += positionalArguments_[index]->getNameView();
+          return ParseResult::MISSING_VALUE;
+        }
+      }
+
+      // Check if there are too many positional arguments
+      if (positionalCount > positionalArguments_.size()) {
+        lastError_ = "Too many positional arguments";
+        return ParseResult::INVALID_VALUE;
+      }
+
+      // Check required option arguments, 64 options per step
+      const std::vector<std::uint64_t>& required = options_.required.words();
+      const std::vector<std::uint64_t>& given = options_.set.words();
+      for (std::size_t word = 0; word < required.size(); ++word) {
+        const std::uint64_t missing = required[word] & ~given[word];
+        if (missing != 0) {
+          const std::size_t index = word * detail::BitVector::kWordBits +
+                                    detail::lowestSetBit(missing);
+          lastError_ = "Missing required option: --";
+          lastError_ += options_.names[index];
+          return ParseResult::MISSING_VALUE;
+        }
+      }
+
+      for (const OptionGroup& group : groups_) {
+        const ParseResult groupResult = checkGroup(group);
+        if (groupResult != ParseResult::SUCCESS) {
+          return groupResult;
+        }
+      }
     }
 
-    isSet_ = true;
-    return true;
+    // Hand the rest of argv to the subcommand, registering its arguments now
+    if (activeSubcommand_ != nullptr) {
+      subcommandParser_ = std::make_unique<Parser>(
+          programName_ + " " + activeSubcommand_->name,
+          activeSubcommand_->description);
+      activeSubcommand_->registerArguments(*subcommandParser_);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const ParseResult result = subcommandParser_->parse(
+          argc - subcommandIndex, argv + subcommandIndex, envp);
+      if (result != ParseResult::SUCCESS) {
+        lastError_ = subcommandParser_->getLastError();
+      }
+      return result;
+    }
+
+    return ParseResult::SUCCESS;
   }
 
   /**
-   * @brief Get the parsed value of this argument
+   * @brief Print help information for all arguments
    *
-   * @return int16_t The parsed value
+   * @param os The output stream to print to (default: std::cout)
+   * @note The help output includes both option arguments and positional
+   * arguments, as well as a usage line showing how to use the program.
    */
-  [[nodiscard]] int16_t getValue() const { return value_; }
+  void printHelp(std::ostream& os = std::cout) const {
+    ARGSPARSER_ALLOCATION_PHASE(HELP);
+    os << "Usage: " << programName_;
 
- protected:
-  /**
-   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
-   * @return The type name or empty string if no type name should be displayed
-   */
-  [[nodiscard]] std::string getTypeName() const override {
-    return "(16-bit integer)";
-  }
+    // Print options
+    const bool hasOptions = !arguments_.empty();
+    if (hasOptions || packedFlags_.size() > 0) {
+      os << " [OPTIONS]";
+    }
 
-  /**
+    if (subcommandCount_ > 0) {
+      os << " <command> [ARGS]";
+    }
 
-   * @brief Get the default value as a string
+    // Print positional arguments
+    for (const auto& arg : positionalArguments_) {
+      os << " ";
+      if (!arg->isRequired()) {
+        os << "[";
+      }
+      os << "<" << arg->getNameView() << ">";
+      if (!arg->isRequired()) {
+        os << "]";
+      }
+    }
+    os << "\n";
 
-   * @return String representation of the default value or empty string if no
+    if (!description_.empty()) {
+      os << description_ << "\n\n";
+    }
 
-   * default
+    // Print option arguments
+    if (hasOptions) {
+      os << "Options:\n";
+      for (std::size_t i = 0; i < arguments_.size(); ++i) {
+        if (!options_.shortNames[i].empty()) {
+          os << "  -" << options_.shortNames[i] << ", --" << options_.names[i];
+        } else {
+          os << "  --" << options_.names[i];
+        }
+        if (options_.required.test(i)) {
+          os << " (required)";
+        }
+        arguments_[i]->printHelpDetails(os);
+      }
+      os << "\n";
+    }
 
-   */
+    // Print packed flags
+    if (packedFlags_.size() > 0) {
+      os << "Flags:\n";
+      for (std::size_t i = 0; i < packedFlags_.size(); ++i) {
+        os << "  --" << packedFlags_.name(i) << "\n";
+      }
+      os << "\n";
+    }
 
-  [[nodiscard]] std::string getDefaultString() const override {
-    return std::to_string(value_);
-  }
+    // Print subcommands
+    if (subcommandCount_ > 0) {
+      os << "Commands:\n";
+      for (std::size_t i = 0; i < subcommandCount_; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const Subcommand& command = subcommands_[i];
+        os << "  " << command.name << "\n    " << command.description << "\n";
+      }
+      os << "\n";
+    }
 
-  /**
+    // Print positional arguments
+    if (!positionalArguments_.empty()) {
+      os << "Positional arguments:\n";
+      for (const auto& arg : positionalArguments_) {
+        arg->printHelp(os);
+      }
+      os << "\n";
+    }
 
-   * @brief Check if the argument has a default value that should be displayed
+    os << "  -h, --help\n    Show this help message\n";
+  }
 
-   * @return true if a default value should be shown, false otherwise
+  /**
+   * @brief Print shell completion candidates for the last completion query
+   *
+   * Call this when parse() returns COMPLETION_REQUESTED (see
+   * enableCompletion()). The last word after `--__complete` is the partial
+   * word being completed; the words before it give context (a subcommand, or
+   * an option whose value is being completed).
+   * Candidates are long options, subcommands and oneOf choices, one per line.
+   * @param os The output stream to print to (default: std::cout)
+   * @note Option names are looked up in a sorted index built once, so a query
+   * costs O(log n) plus the number of matches and does not allocate.
+   */
+  void printCompletions(std::ostream& os = std::cout) {
+    completeWords(completionWordCount_, completionWords_, os);
+  }
 
+  /**
+   * @brief Print a bash completion script for this program
+   *
+   * The script calls back into the program with `--__complete`, so it stays
+   * correct as options change. Install it with e.g.
+   * `prog --bash-completion > /etc/bash_completion.d/prog`.
+   * @param os The output stream to print to (default: std::cout)
    */
+  void printBashCompletion(std::ostream& os = std::cout) const {
+    const std::string function = completionFunctionName();
+    os << function << "() {\n"
+       << "  local IFS=$'\\n'\n"
+       << "  COMPREPLY=($(\"${COMP_WORDS[0]}\" " << detail::kCompleteFlag
+       << " \"${COMP_WORDS[@]:1:COMP_CWORD}\" 2>/dev/null))\n"
+       << "}\n"
+       << "complete -o default -F " << function << " " << programName_
+       << "\n";
+  }
 
-  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
-};
+  /**
+   * @brief Print a zsh completion script for this program
+   *
+   * @param os The output stream to print to (default: std::cout)
+   * @see printBashCompletion
+   */
+  void printZshCompletion(std::ostream& os = std::cout) const {
+    const std::string function = completionFunctionName();
+    os << "#compdef " << programName_ << "\n"
+       << function << "() {\n"
+       << "  local -a candidates\n"
+       << "  candidates=(\"${(@f)$(${words[1]} " << detail::kCompleteFlag
+       << " \"${(@)words[2,CURRENT]}\" 2>/dev/null)}\")\n"
+       << "  compadd -- $candidates\n"
+       << "}\n"
+       << "compdef " << function << " " << programName_ << "\n";
+  }
 
-/**
- * @brief Specialization for 32-bit unsigned integer arguments
- *
- * This specialization handles 32-bit unsigned integer arguments, which require
- * conversion from string to uint32_t during parsing.
- */
-template <>
-class Argument<uint32_t> : public ArgumentBase {
- public:
   /**
-   * @brief Validator function type for 32-bit unsigned integer arguments
+   * @brief Check if an argument has been set
    *
-   * A validator is a function that takes a uint32_t value and returns
-   * true if the value is valid, false otherwise.
+   * The name is resolved through a hash index built at registration; use
+   * an ArgumentHandle to skip even that in hot loops.
+   * @param name The name of the argument to check
+   * @return true if the argument was provided, false otherwise
+   * @note Works for both option arguments and positional arguments.
    */
-  using Validator = std::function<bool(uint32_t)>;
+  [[nodiscard]] bool isSet(std::string_view name) const {
+    // Options first, then packed flags, then positional arguments
+    const detail::NameTable::Entry* entry = nameTable_.find(name);
+    if (entry != nullptr && !entry->positional) {
+      return entry->argument->isSet();
+    }
 
- private:
-  uint32_t value_;
-  Validator validator_;
+    const std::size_t flag = packedFlags_.find(name);
+    if (flag != FlagSet::npos) {
+      return packedFlags_.test(flag);
+    }
+
+    return entry != nullptr && entry->argument->isSet();
+  }
 
- public:
   /**
-   * @brief Construct a new Argument object for 32-bit unsigned integer values
+   * @brief Get the parsed value of an argument
    *
-   * @param name The long name of the argument (e.g., "count")
-   * @param shortName The short name of the argument (e.g., "c")
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
-   * @param defaultValue The default value for this argument (default: 0)
+   * The name and the value type are resolved through a hash index built at
+   * registration; use an ArgumentHandle to skip even that in hot loops.
+   * @tparam T The type of the argument value
+   * @param name The name of the argument
+   * @return const T& The parsed value of the argument
+   * @note If the argument doesn't exist or the type doesn't match, a default
+   * constructed value is returned.
    */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool required = false,
-           uint32_t defaultValue = 0)
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {}
+  template <typename T>
+  const T& getValue(std::string_view name) const {
+    const detail::NameTable::Entry* entry = nameTable_.find(name);
+    constexpr std::uint8_t type = detail::TypeCodeOf<T>::value;
+    if (entry != nullptr && entry->type == type &&
+        type != detail::kUntypedArgument) {
+      return static_cast<const Argument<T>*>(entry->argument)->getValue();
+    }
+
+    // Value types without a type code, and mismatches
+    auto it = longNameMap_.find(name);
+    if (it != longNameMap_.end()) {
+      // This is safe because we know the type matches
+      auto* arg = dynamic_cast<Argument<T>*>(it->second);
+      if (arg) {
+        return arg->getValue();
+      }
+    }
+
+    // Check positional arguments
+    for (const auto& arg : positionalArguments_) {
+      if (arg->getNameView() == name) {
+        // This is safe because we know the type matches
+        auto* posArg = dynamic_cast<Argument<T>*>(arg.get());
+        if (posArg) {
+          return posArg->getValue();
+        }
+      }
+    }
+
+    // This should not happen in correct usage
+    static T defaultValue{};
+    return defaultValue;
+  }
 
   /**
-   * @brief Set a validator function for this argument
+   * @brief Resolve an argument once for repeated typed access
    *
-   * The validator function will be called during parsing to validate the value.
-   * @param validator The validator function to use
+   * @tparam T The type of the argument value
+   * @param name The name of an option or positional argument
+   * @return ArgumentHandle<T> The handle; empty if the name is unknown or
+   * the argument holds another type
    */
-  void setValidator(const Validator& validator) { validator_ = validator; }
+  template <typename T>
+  [[nodiscard]] ArgumentHandle<T> getHandle(std::string_view name) const {
+    const detail::NameTable::Entry* entry = nameTable_.find(name);
+    if (entry == nullptr) {
+      return ArgumentHandle<T>();
+    }
+    return ArgumentHandle<T>(
+        dynamic_cast<const Argument<T>*>(entry->argument));
+  }
 
   /**
-   * @brief Parse a string value into a 32-bit unsigned integer
+   * @brief Copy the current values into flat arrays
    *
-   * @param value The string value to parse
-   * @return true if parsing and validation were successful, false otherwise
-   * @note Negative values will be rejected even if they would fit in the
-   * unsigned type.
+   * Numbers and bools are stored bitwise, so two PackedValues of the same
+   * schema compare with word-wide operations instead of getValue() lookups.
+   * Arguments of types other than those of ArgumentType get a zero slot.
+   * @param out Receives the values (previous contents are replaced)
    */
-  bool parse(const std::string& value) override {
-    char* end = nullptr;
-    errno = 0;  // Reset errno before calling strtoul
-    constexpr auto radix = 10;
-    const unsigned long parsedValue = std::strtoul(value.c_str(), &end, radix);
+  void packValues(PackedValues& out) const {
+    const std::size_t count = arguments_.size() +
+                              positionalArguments_.size() +
+                              packedFlags_.size();
+    out = PackedValues();
+    out.names.reserve(count);
+    out.slots.reserve(count);
+    out.text.reserve(count);
+    out.set.reserve(count);
+    for (const auto& argument : arguments_) {
+      packValue(*argument, out);
+    }
+    for (const auto& argument : positionalArguments_) {
+      packValue(*argument, out);
+    }
+    for (std::size_t i = 0; i < packedFlags_.size(); ++i) {
+      out.names.push_back(packedFlags_.name(i));
+      out.slots.push_back(packedFlags_.test(i) ? 1 : 0);
+      out.text.emplace_back();
+      out.set.pushBack(packedFlags_.test(i));
+    }
+  }
 
-    // Check if the entire string was consumed
-    if (*end != '\0') {
-      return false;
+  /**
+   * @brief Serialize the schema into a relocatable binary blob
+   *
+   * The blob holds the names, descriptions, type tags, current values (as
+   * defaults), sorted name indexes and the rendered help text, and is loaded
+   * by FrozenSchema without per-option work. Validators, environment
+   * bindings, packed flags and subcommands are not included.
+   * @note The current values are recorded as the defaults. Call this before
+   * parse() (and before parseConfigFile()); afterwards the parsed values
+   * would be frozen in place of the registered defaults.
+   * @param out Receives the blob
+   * @return true on success; false if an argument has a type other than
+   * those of ArgumentType, with the reason in getLastError()
+   */ // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  bool freezeSchema(std::string& out) {
+    std::vector<detail::FrozenRecord> records(arguments_.size() +
+                                              positionalArguments_.size());
+    std::string pool;
+    auto intern = [&pool](std::string_view text) {
+      const detail::FrozenString entry{static_cast<std::uint32_t>(pool.size()),
+                                       static_cast<std::uint32_t>(text.size())};
+      pool.append(text.data(), text.size());
+      return entry;
+    };
+
+    std::string defaultText;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      const ArgumentBase& argument =
+          i < arguments_.size() ? *arguments_[i]
+                                : *positionalArguments_[i - arguments_.size()];
+      ArgumentType type{};
+      if (!frozenType(argument, type, defaultText)) {
+        lastError_ = "Cannot freeze argument of custom type: ";
+        lastError_ += argument.getNameView();
+        return false;
+      }
+      detail::FrozenRecord& record = records[i];
+      record.name = intern(argument.getNameView());
+      record.shortName = intern(argument.getShortNameView());
+      record.description = intern(argument.getDescriptionView());
+      record.defaultValue = intern(defaultText);
+      record.type = static_cast<std::uint8_t>(type);
+      record.flags = argument.isRequired() ? detail::kFrozenRequired : 0U;
     }
 
-    // Check for overflow or negative values (strtoul would wrap negatives)
-    if (errno == ERANGE || parsedValue > UINT32_MAX) {
-      return false;
+    // The maps are sorted already; later registrations of a name win
+    std::vector<detail::FrozenIndexEntry> longIndex;
+    longIndex.reserve(longNameMap_.size());
+    for (const auto& entry : longNameMap_) {
+      const auto index = static_cast<std::uint32_t>(entry.second->getIndex());
+      longIndex.push_back({records[index].name, index});
+    }
+    std::vector<detail::FrozenIndexEntry> shortIndex;
+    for (const auto& entry : shortNameMap_) {
+      if (!entry.first.empty()) {
+        const auto index =
+            static_cast<std::uint32_t>(entry.second->getIndex());
+        shortIndex.push_back({records[index].shortName, index});
+      }
     }
 
-    // Check for negative values by looking at the original string
-    if (!value.empty() && value[0] == '-') {
+    std::ostringstream help;
+    printHelp(help);
+    detail::FrozenHeader header;
+    header.help = intern(help.str());
+    if (pool.size() > UINT32_MAX || records.size() > UINT32_MAX) {
+      lastError_ = "Schema too large to freeze";
       return false;
     }
 
-    value_ = static_cast<uint32_t>(parsedValue);
-
-    if (validator_ && !validator_(value_)) {
-      return false;
+    header.magic = detail::kFrozenMagic;
+    header.version = detail::kFrozenVersion;
+    header.optionCount = static_cast<std::uint32_t>(arguments_.size());
+    header.positionalCount =
+        static_cast<std::uint32_t>(positionalArguments_.size());
+    // Duplicate long names leave fewer index entries than options
+    header.longIndexCount = static_cast<std::uint32_t>(longIndex.size());
+    header.shortIndexCount = static_cast<std::uint32_t>(shortIndex.size());
+    header.stringBytes = static_cast<std::uint32_t>(pool.size());
+
+    std::string payload;
+    payload.reserve(records.size() * sizeof(detail::FrozenRecord) +
+                    (longIndex.size() + shortIndex.size()) *
+                        sizeof(detail::FrozenIndexEntry) +
+                    pool.size());
+    for (const detail::FrozenRecord& record : records) {
+      detail::appendBytes(payload, record);
+    }
+    for (const detail::FrozenIndexEntry& entry : longIndex) {
+      detail::appendBytes(payload, entry);
     }
+    for (const detail::FrozenIndexEntry& entry : shortIndex) {
+      detail::appendBytes(payload, entry);
+    }
+    payload += pool;
+    header.hash = detail::fnv1a(payload);
 
-    isSet_ = true;
+    out.clear();
+    out.reserve(sizeof(header) + payload.size());
+    detail::appendBytes(out, header);
+    out += payload;
     return true;
   }
 
+ private:
   /**
-   * @brief Get the parsed value of this argument
-   *
-   * @return uint32_t The parsed value
+   * @brief Get the type tag and default text of an argument to freeze
+   * @param argument The argument
+   * @param type Receives the type tag
+   * @param defaultText Receives the current value in command-line syntax,
+   * or "" if it is the type's zero value
+   * @return true if the argument has one of the ArgumentType types
    */
-  [[nodiscard]] uint32_t getValue() const { return value_; }
+  static bool frozenType(const ArgumentBase& argument, ArgumentType& type,
+                         std::string& defaultText) {
+    return frozenTypeAs<bool>(argument, type, defaultText) ||
+           frozenTypeAs<std::string>(argument, type, defaultText) ||
+           frozenTypeAs<int16_t>(argument, type, defaultText) ||
+           frozenTypeAs<uint32_t>(argument, type, defaultText) ||
+           frozenTypeAs<int32_t>(argument, type, defaultText) ||
+           frozenTypeAs<uint64_t>(argument, type, defaultText) ||
+           frozenTypeAs<int64_t>(argument, type, defaultText) ||
+           frozenTypeAs<float>(argument, type, defaultText) ||
+           frozenTypeAs<double>(argument, type, defaultText);
+  }
 
- protected:
   /**
-   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
-   * @return The type name or empty string if no type name should be displayed
+   * @brief frozenType() for one candidate type
    */
-  [[nodiscard]] std::string getTypeName() const override {
-    return "(32-bit unsigned integer)";
+  template <typename T>
+  static bool frozenTypeAs(const ArgumentBase& argument, ArgumentType& type,
+                           std::string& defaultText) {
+    const auto* typed = dynamic_cast<const Argument<T>*>(&argument);
+    if (typed == nullptr) {
+      return false;
+    }
+    type = detail::ArgumentTypeOf<T>::value;
+    const T& value = typed->getValue();
+    if constexpr (std::is_same_v<T, std::string>) {
+      defaultText = value;
+    } else if constexpr (std::is_same_v<T, bool>) {
+      defaultText = value ? "true" : "";
+    } else if constexpr (std::is_floating_point_v<T>) {
+      // Enough digits to convert back to the same value
+      std::array<char, 32> buffer{};
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+      std::snprintf(buffer.data(), buffer.size(),
+                    std::is_same_v<T, float> ? "%.9g" : "%.17g",
+                    static_cast<double>(value));
+      defaultText = value != 0 ? buffer.data() : "";
+    } else {
+      defaultText = value != 0 ? std::to_string(value) : "";
+    }
+    return true;
   }
 
   /**
-   * @brief Get the default value as a string
-   * @return String representation of the default value or empty string if no
-   * default
+   * @brief Append one argument to a PackedValues
    */
-  [[nodiscard]] std::string getDefaultString() const override {
-    return std::to_string(value_);
+  static void packValue(const ArgumentBase& argument, PackedValues& out) {
+    out.names.push_back(argument.getNameView());
+    out.set.pushBack(argument.isSet());
+    const bool packed = packValueAs<bool>(argument, out) ||
+                        packValueAs<std::string>(argument, out) ||
+                        packValueAs<int16_t>(argument, out) ||
+                        packValueAs<uint32_t>(argument, out) ||
+                        packValueAs<int32_t>(argument, out) ||
+                        packValueAs<uint64_t>(argument, out) ||
+                        packValueAs<int64_t>(argument, out) ||
+                        packValueAs<float>(argument, out) ||
+                        packValueAs<double>(argument, out);
+    if (!packed) {
+      out.slots.push_back(0);
+      out.text.emplace_back();
+    }
   }
 
   /**
-   * @brief Check if the argument has a default value that should be displayed
-   * @return true if a default value should be shown, false otherwise
+   * @brief packValue() for one candidate type
    */
-  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
-};
+  template <typename T>
+  static bool packValueAs(const ArgumentBase& argument, PackedValues& out) {
+    const auto* typed = dynamic_cast<const Argument<T>*>(&argument);
+    if (typed == nullptr) {
+      return false;
+    }
+    const T& value = typed->getValue();
+    std::uint64_t slot = 0;
+    if constexpr (std::is_same_v<T, std::string>) {
+      slot = detail::fnv1a(value);
+      out.text.emplace_back(value);
+    } else {
+      std::memcpy(&slot, &value, sizeof(T));
+      out.text.emplace_back();
+    }
+    out.slots.push_back(slot);
+    return true;
+  }
 
-/**
- * @brief Specialization for 32-bit integer arguments
- *
- * This specialization handles 32-bit integer arguments, which require
- * conversion from string to int32_t during parsing.
- */
-template <>
-class Argument<int32_t> : public ArgumentBase {
- public:
   /**
-   * @brief Validator function type for 32-bit integer arguments
-   *
-   * A validator is a function that takes an int32_t value and returns
-   * true if the value is valid, false otherwise.
+   * @brief Build the sorted subcommand index if the table is unsorted
    */
-  using Validator = std::function<bool(int32_t)>;
-
- private:
-  int32_t value_;
-  Validator validator_;
+  void ensureSubcommandOrder() {
+    if (subcommandsSorted_ || !subcommandOrder_.empty()) {
+      return;
+    }
+    subcommandOrder_.resize(subcommandCount_);
+    for (std::size_t i = 0; i < subcommandCount_; ++i) {
+      subcommandOrder_[i] = i;
+    }
+    std::sort(subcommandOrder_.begin(), subcommandOrder_.end(),
+              [this](std::size_t lhs, std::size_t rhs) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                return std::strcmp(subcommands_[lhs].name,
+                                   subcommands_[rhs].name) < 0;
+              });
+  }
 
- public:
   /**
-   * @brief Construct a new Argument object for 32-bit integer values
+   * @brief Get the subcommand at a position of the sorted order
    *
-   * @param name The long name of the argument (e.g., "count")
-   * @param shortName The short name of the argument (e.g., "c")
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
-   * @param defaultValue The default value for this argument (default: 0)
+   * @param position Position in name order, in [0, subcommandCount_)
+   * @return The table entry
    */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool required = false,
-           int32_t defaultValue = 0)
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {}
+  [[nodiscard]] const Subcommand& subcommandAt(std::size_t position) const {
+    const std::size_t index =
+        subcommandsSorted_ ? position : subcommandOrder_[position];
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return subcommands_[index];
+  }
 
   /**
-   * @brief Set a validator function for this argument
+   * @brief Find the first subcommand (in name order) not less than a name
    *
-   * The validator function will be called during parsing to validate the value.
-   * @param validator The validator function to use
+   * @param name The name or prefix to search for
+   * @return Position in name order, or subcommandCount_ if there is none
    */
-  void setValidator(const Validator& validator) { validator_ = validator; }
+  std::size_t subcommandLowerBound(std::string_view name) {
+    ensureSubcommandOrder();
+    std::size_t low = 0;
+    std::size_t high = subcommandCount_;
+    while (low < high) {
+      const std::size_t middle = low + (high - low) / 2;
+      if (std::string_view(subcommandAt(middle).name) < name) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
 
   /**
-   * @brief Parse a string value into a 32-bit integer
+   * @brief Look up a subcommand by name through the sorted index
    *
-   * @param value The string value to parse
-   * @return true if parsing and validation were successful, false otherwise
+   * @param name The candidate subcommand name
+   * @return The matching table entry, or nullptr if there is none
    */
-  bool parse(const std::string& value) override {
-    char* end = nullptr;
-    errno = 0;  // Reset errno before calling strtol
-    constexpr auto radix = 10;
-    const long parsedValue = std::strtol(value.c_str(), &end, radix);
-
-    // Check if the entire string was consumed
-    if (*end != '\0') {
-      return false;
-    }
-
-    // Check for overflow/underflow
-    if (errno == ERANGE || parsedValue > INT32_MAX || parsedValue < INT32_MIN) {
-      return false;
+  const Subcommand* findSubcommand(std::string_view name) {
+    if (subcommandCount_ == 0) {
+      return nullptr;
     }
-
-    value_ = static_cast<int32_t>(parsedValue);
-
-    if (validator_ && !validator_(value_)) {
-      return false;
+    const std::size_t position = subcommandLowerBound(name);
+    if (position == subcommandCount_ ||
+        std::string_view(subcommandAt(position).name) != name) {
+      return nullptr;
     }
-
-    isSet_ = true;
-    return true;
+    return &subcommandAt(position);
   }
 
   /**
-   * @brief Get the parsed value of this argument
-   *
-   * @return int32_t The parsed value
+   * @brief Append an option to the packed option table
+   * @param argument The option, already created
+   * @param isFlag Whether the option is a boolean flag
    */
-  [[nodiscard]] int32_t getValue() const { return value_; }
+  void registerOption(ArgumentBase* argument, bool isFlag) {
+    argument->setIndex(options_.names.size());
+    options_.names.push_back(argument->getNameView());
+    options_.shortNames.push_back(argument->getShortNameView());
+    options_.required.pushBack(argument->isRequired());
+    options_.flags.pushBack(isFlag);
+    options_.set.pushBack(argument->isSet());
+  }
 
- protected:
   /**
-   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
-   * @return The type name or empty string if no type name should be displayed
+   * @brief Check an option group against the options given so far
+   * @param group The group
+   * @return ParseResult SUCCESS, INVALID_VALUE if mutually exclusive options
+   * were combined, or MISSING_VALUE if the group is incomplete
    */
-  [[nodiscard]] std::string getTypeName() const override {
-    return "(32-bit integer)";
+  ParseResult checkGroup(const OptionGroup& group) {
+    const std::vector<std::uint64_t>& members = group.members.words();
+    const std::vector<std::uint64_t>& given = options_.set.words();
+    std::size_t count = 0;
+    for (std::size_t word = 0; word < members.size(); ++word) {
+      count += detail::popCount(members[word] & given[word]);
+    }
+    const char* message = nullptr;
+    bool listGiven = false;
+    ParseResult result = ParseResult::MISSING_VALUE;
+    switch (group.kind) {
+      case GroupKind::MUTUALLY_EXCLUSIVE:
+        if (count > 1) {
+          message = "Options cannot be used together: ";
+          listGiven = true;
+          result = ParseResult::INVALID_VALUE;
+        }
+        break;
+      case GroupKind::AT_LEAST_ONE:
+        if (count == 0) {
+          message = "One of these options is required: ";
+        }
+        break;
+      case GroupKind::ALL_OR_NONE:
+        if (count != 0 && count != group.size) {
+          message = "Options must be used together: ";
+        }
+        break;
+    }
+    if (message == nullptr) {
+      return ParseResult::SUCCESS;
+    }
+
+    // Name the options that were combined, or all members
+    lastError_ = message;
+    bool first = true;
+    for (std::size_t word = 0; word < members.size(); ++word) {
+      std::uint64_t bits =
+          listGiven ? members[word] & given[word] : members[word];
+      while (bits != 0) {
+        lastError_ += first ? "--" : ", --";
+        first = false;
+        lastError_ += options_.names[word * detail::BitVector::kWordBits +
+                                     detail::lowestSetBit(bits)];
+        bits &= bits - 1;
+      }
+    }
+    return result;
   }
 
   /**
-   * @brief Get the default value as a string
-   * @return String representation of the default value or empty string if no
-   * default
+   * @brief Check whether an option is a boolean flag
+   * @param argument An option registered with this parser
    */
-  [[nodiscard]] std::string getDefaultString() const override {
-    return std::to_string(value_);
+  [[nodiscard]] bool isFlag(const ArgumentBase* argument) const {
+    return options_.flags.test(argument->getIndex());
   }
 
   /**
-   * @brief Check if the argument has a default value that should be displayed
-   * @return true if a default value should be shown, false otherwise
+   * @brief Record that an argument received a value
+   * @param argument The argument (option or positional)
+   * @param source Where the value came from
    */
-  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
-};
+  void markSet(ArgumentBase* argument, ValueSource source) {
+    argument->setSource(source);
+    if (argument->getIndex() < options_.set.size()) {
+      options_.set.set(argument->getIndex());
+    }
+  }
 
-/**
- * @brief Specialization for 64-bit unsigned integer arguments
- *
- * This specialization handles 64-bit unsigned integer arguments, which require
- * conversion from string to uint64_t during parsing.
- */
-template <>
-class Argument<uint64_t> : public ArgumentBase {
- public:
   /**
-   * @brief Validator function type for 64-bit unsigned integer arguments
-   *
-   * A validator is a function that takes a uint64_t value and returns
-   * true if the value is valid, false otherwise.
+   * @brief Command-line lookups and stores for detail::tokenizeArguments()
    */
-  using Validator = std::function<bool(uint64_t)>;
+  struct CommandLineHooks {
+    /// An option, or a packed flag when argument is nullptr
+    struct Key {
+      ArgumentBase* argument{nullptr};
+      std::size_t packedFlag{FlagSet::npos};
+    };
+
+    Parser& parser;
+    /// Number of positional values seen (may exceed the registered count)
+    std::size_t positionalCount{0};
+    /// argv index of the subcommand name, or 0 if there is none
+    int subcommandIndex{0};
+
+    [[nodiscard]] bool done() const { return subcommandIndex != 0; }
+
+    [[nodiscard]] Key findShort(std::string_view name) const {
+      auto it = parser.shortNameMap_.find(name);
+      return {it == parser.shortNameMap_.end() ? nullptr : it->second};
+    }
 
- private:
-  uint64_t value_;
-  Validator validator_;
+    [[nodiscard]] bool isFlag(const Key& key) const {
+      return key.packedFlag != FlagSet::npos ||
+             (key.argument != nullptr && parser.isFlag(key.argument));
+    }
 
- public:
-  /**
-   * @brief Construct a new Argument object for 64-bit unsigned integer values
-   *
-   * @param name The long name of the argument (e.g., "count")
-   * @param shortName The short name of the argument (e.g., "c")
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
-   * @param defaultValue The default value for this argument (default: 0)
-   */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool required = false,
-           uint64_t defaultValue = 0)
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {}
+    [[nodiscard]] bool takesValue(const Key& key) const {
+      return key.argument != nullptr && !parser.isFlag(key.argument);
+    }
 
-  /**
-   * @brief Set a validator function for this argument
-   *
-   * The validator function will be called during parsing to validate the value.
-   * @param validator The validator function to use
-   */
-  void setValidator(const Validator& validator) { validator_ = validator; }
+    ParseResult positional(int index, std::string_view arg,
+                           bool optionsEnded) {
+      if (parser.subcommandCount_ > 0 && !optionsEnded) {
+        parser.activeSubcommand_ = parser.findSubcommand(arg);
+        if (parser.activeSubcommand_ != nullptr) {
+          // Everything from here on belongs to the subcommand
+          subcommandIndex = index;
+          return ParseResult::SUCCESS;
+        }
+        if (parser.positionalArguments_.empty()) {
+          parser.lastError_ = "Unknown subcommand: ";
+          parser.lastError_ += arg;
+          if (const Subcommand* suggestion = parser.suggestSubcommand(arg)) {
+            parser.lastError_ +=
+                std::string(" (did you mean ") + suggestion->name + "?)";
+          }
+          return ParseResult::UNKNOWN_OPTION;
+        }
+      }
 
-  /**
-   * @brief Parse a string value into a 64-bit unsigned integer
-   *
-   * @param value The string value to parse
-   * @return true if parsing and validation were successful, false otherwise
-   * @note Negative values will be rejected even if they would fit in the
-   * unsigned type.
-   */
-  bool parse(const std::string& value) override {
-    char* end = nullptr;
-    errno = 0;  // Reset errno before calling strtoull
-    constexpr auto radix = 10;
-    const unsigned long long parsedValue =
-        std::strtoull(value.c_str(), &end, radix);
-
-    // Check if the entire string was consumed
-    if (*end != '\0') {
-      return false;
+      // Positional argument, assigned in order of appearance
+      if (positionalCount < parser.positionalArguments_.size()) {
+        ArgumentBase* argument =
+            parser.positionalArguments_[positionalCount].get();
+        ARGSPARSER_PARSE_STEP(CONVERT, index, argument->getNameView());
+        if (!argument->parseView(arg)) {
+          parser.lastError_ = "Invalid value for positional argument: ";
+          parser.lastError_ += argument->getNameView();
+          parser.lastError_ += " = ";
+          parser.lastError_ += arg;
+          return ParseResult::INVALID_VALUE;
+        }
+        parser.markSet(argument, ValueSource::COMMAND_LINE);
+      }
+      ++positionalCount;
+      return ParseResult::SUCCESS;
     }
 
-    // Check for overflow or negative values (strtoull would wrap negatives)
-    if (errno == ERANGE || parsedValue > UINT64_MAX) {
-      return false;
+    ParseResult lookup(const detail::OptionToken& token, Key& key) {
+      ARGSPARSER_PARSE_STEP(LOOKUP, token.index, token.name);
+      if (!token.isLong) {
+        key = findShort(token.name);
+        return ParseResult::SUCCESS;
+      }
+      auto it = parser.longNameMap_.find(token.name);
+      if (it != parser.longNameMap_.end()) {
+        key.argument = it->second;
+        return ParseResult::SUCCESS;
+      }
+      key.packedFlag = parser.packedFlags_.find(token.name);
+      if (key.packedFlag == FlagSet::npos && parser.allowAbbreviations_) {
+        return parser.resolveAbbreviation(token.name, key.argument);
+      }
+      return ParseResult::SUCCESS;
     }
 
-    // Check for negative values by looking at the original string
-    if (!value.empty() && value[0] == '-') {
-      return false;
+    ParseResult unknown(const detail::OptionToken& token) {
+      ARGSPARSER_STATISTICS_COUNT(lookupMisses);
+      parser.lastError_ = std::string("Unknown option: ") + token.dashes();
+      parser.lastError_ += token.name;
+      if (token.isLong) {
+        if (const ArgumentBase* suggestion = parser.suggestOption(token.name)) {
+          parser.lastError_ += " (did you mean --";
+          parser.lastError_ += suggestion->getNameView();
+          parser.lastError_ += "?)";
+        }
+      }
+      return ParseResult::UNKNOWN_OPTION;
+    }
+
+    ParseResult flag(const detail::OptionToken& token, const Key& key) {
+      if (key.argument == nullptr) {
+        // "--name=value" takes a boolean value, so "=false" clears it
+        bool enabled = true;
+        if (token.hasValue && !convertValue(token.value, enabled)) {
+          return invalidValue(token);
+        }
+        if (enabled) {
+          parser.packedFlags_.set(key.packedFlag);
+        } else {
+          parser.packedFlags_.reset(key.packedFlag);
+        }
+        return ParseResult::SUCCESS;
+      }
+      ARGSPARSER_PARSE_STEP(CONVERT, token.index, key.argument->getNameView());
+      if (!key.argument->parseView("true")) {
+        parser.lastError_ =
+            std::string("Invalid value for flag: ") + token.dashes();
+        parser.lastError_ += token.name;
+        return ParseResult::INVALID_VALUE;
+      }
+      parser.markSet(key.argument, ValueSource::COMMAND_LINE);
+      return ParseResult::SUCCESS;
     }
 
-    value_ = static_cast<uint64_t>(parsedValue);
+    ParseResult missingValue(const detail::OptionToken& token) {
+      parser.lastError_ =
+          std::string("Missing value for option: ") + token.dashes();
+      parser.lastError_ += token.name;
+      return ParseResult::MISSING_VALUE;
+    }
 
-    if (validator_ && !validator_(value_)) {
-      return false;
+    ParseResult store(const detail::OptionToken& token, const Key& key) {
+      ARGSPARSER_PARSE_STEP(CONVERT, token.valueIndex,
+                            key.argument->getNameView());
+      if (!key.argument->parseView(token.value)) {
+        return invalidValue(token);
+      }
+      parser.markSet(key.argument, ValueSource::COMMAND_LINE);
+      return ParseResult::SUCCESS;
     }
 
-    isSet_ = true;
-    return true;
+    ParseResult invalidValue(const detail::OptionToken& token) {
+      std::string error = "Invalid value for option: ";
+      error += token.dashes();
+      error += token.name;
+      error += " = ";
+      error += token.value;
+      parser.lastError_ = std::move(error);
+      return ParseResult::INVALID_VALUE;
+    }
+  };
+
+  /**
+   * @brief Create the argument described by a table entry
+   * @param descriptor The table entry
+   * @param shortView The entry's short name ("" for none)
+   * @param storage Whether the entry's strings are referenced or copied
+   * @return std::unique_ptr<ArgumentBase> The argument, holding T{}
+   */
+  static std::unique_ptr<ArgumentBase> makeArgument(
+      const ArgumentDescriptor& descriptor, std::string_view shortView,
+      StringStorage storage) {
+    std::unique_ptr<ArgumentBase> argument =
+        makeUnnamedArgument(descriptor.type, descriptor.required);
+    argument->setStrings(
+        descriptor.name, shortView,
+        descriptor.description != nullptr ? descriptor.description : "",
+        storage);
+    return argument;
   }
 
   /**
-   * @brief Get the parsed value of this argument
-   *
-   * @return uint64_t The parsed value
+   * @brief Create an argument of the given type with empty strings
+   * @param type The value type
+   * @param required Whether the argument is required (ignored for flags)
+   * @return std::unique_ptr<ArgumentBase> The argument, holding T{}
    */
-  [[nodiscard]] uint64_t getValue() const { return value_; }
+  static std::unique_ptr<ArgumentBase> makeUnnamedArgument(ArgumentType type,
+                                                           bool required) {
+    const std::string_view none;
+    switch (type) {
+      case ArgumentType::BOOL:
+        return std::make_unique<Argument<bool>>(none, none, none, false, false);
+      case ArgumentType::STRING:
+        return std::make_unique<Argument<std::string>>(none, none, none,
+                                                       required);
+      case ArgumentType::INT16:
+        return std::make_unique<Argument<int16_t>>(none, none, none, required);
+      case ArgumentType::UINT32:
+        return std::make_unique<Argument<uint32_t>>(none, none, none, required);
+      case ArgumentType::INT32:
+        return std::make_unique<Argument<int32_t>>(none, none, none, required);
+      case ArgumentType::UINT64:
+        return std::make_unique<Argument<uint64_t>>(none, none, none, required);
+      case ArgumentType::INT64:
+        return std::make_unique<Argument<int64_t>>(none, none, none, required);
+      case ArgumentType::FLOAT:
+        return std::make_unique<Argument<float>>(none, none, none, required);
+      case ArgumentType::DOUBLE:
+        break;
+    }
+    return std::make_unique<Argument<double>>(none, none, none, required);
+  }
 
- protected:
   /**
-   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
-   * @return The type name or empty string if no type name should be displayed
+   * @brief Rebuild the sorted long-name index if arguments were added
    */
-  [[nodiscard]] std::string getTypeName() const override {
-    return "(64-bit unsigned integer)";
+  void ensureNameIndex() {
+    if (!nameIndexDirty_) {
+      return;
+    }
+    nameIndex_.clear();
+    nameIndex_.reserve(longNameMap_.size());
+    // std::map iterates in key order, so the index comes out sorted
+    for (const auto& entry : longNameMap_) {
+      nameIndex_.push_back(entry.second);
+    }
+    nameIndexDirty_ = false;
   }
 
   /**
-   * @brief Get the default value as a string
-   * @return String representation of the default value or empty string if no
-   * default
+   * @brief Find the first indexed long name not less than a prefix
+   *
+   * @param prefix The prefix to search for
+   * @return Iterator into nameIndex_
    */
-  [[nodiscard]] std::string getDefaultString() const override {
-    return std::to_string(value_);
+  [[nodiscard]] std::vector<ArgumentBase*>::const_iterator nameLowerBound(
+      std::string_view prefix) const {
+    return std::lower_bound(nameIndex_.begin(), nameIndex_.end(), prefix,
+                            [](const ArgumentBase* arg, std::string_view key) {
+                              return arg->getNameView() < key;
+                            });
   }
 
   /**
-   * @brief Check if the argument has a default value that should be displayed
-   * @return true if a default value should be shown, false otherwise
+   * @brief Resolve an abbreviated long option through the sorted index
+   *
+   * @param prefix The name given on the command line (without "--")
+   * @param argument Set to the unique option starting with the prefix, or
+   * left nullptr if no option does
+   * @return ParseResult SUCCESS, or UNKNOWN_OPTION if the prefix is ambiguous
    */
-  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
-};
+  ParseResult resolveAbbreviation(std::string_view prefix,
+                                  ArgumentBase*& argument) {
+    ensureNameIndex();
+    const auto startsWithPrefix = [prefix](const ArgumentBase* candidate) {
+      return candidate->getNameView().substr(0, prefix.size()) == prefix;
+    };
+    auto it = nameLowerBound(prefix);
+    if (prefix.empty() || it == nameIndex_.end() || !startsWithPrefix(*it)) {
+      return ParseResult::SUCCESS;
+    }
+    auto next = std::next(it);
+    if (next != nameIndex_.end() && startsWithPrefix(*next)) {
+      lastError_ = "Ambiguous option: --";
+      lastError_.append(prefix.data(), prefix.size());
+      lastError_ += " (could be --";
+      lastError_ += (*it)->getNameView();
+      lastError_ += ", --";
+      lastError_ += (*next)->getNameView();
+      if (std::next(next) != nameIndex_.end() &&
+          startsWithPrefix(*std::next(next))) {
+        lastError_ += ", ...";
+      }
+      lastError_ += ")";
+      return ParseResult::UNKNOWN_OPTION;
+    }
+    argument = *it;
+    return ParseResult::SUCCESS;
+  }
 
-/**
- * @brief Specialization for 64-bit integer arguments
- *
- * This specialization handles 64-bit integer arguments, which require
- * conversion from string to int64_t during parsing.
- */
-template <>
-class Argument<int64_t> : public ArgumentBase {
- public:
   /**
-   * @brief Validator function type for 64-bit integer arguments
+   * @brief Find the closest long option name for an unknown option
    *
-   * A validator is a function that takes an int64_t value and returns
-   * true if the value is valid, false otherwise.
+   * Only runs on the error path. Names are organized in a BK-tree, built on
+   * the first call after registration. The tree is keyed by Levenshtein
+   * distance, which is a metric, so a query visits only the subtrees whose
+   * edge distances can still lead to a match. Matches are then ranked by
+   * detail::editDistance, where a transposed pair counts as one edit.
+   * @param name The unknown name (without "--")
+   * @return The closest option within detail::suggestionTolerance, or
+   * nullptr if there is none
    */
-  using Validator = std::function<bool(int64_t)>;
+  const ArgumentBase* suggestOption(std::string_view name) {
+    buildSuggestionTree();
+    if (suggestionTree_.empty()) {
+      return nullptr;
+    }
 
- private:
-  int64_t value_;
-  Validator validator_;
+    const std::size_t tolerance = detail::suggestionTolerance(name);
+    // A transposition is two Levenshtein edits, so every name within the
+    // tolerance is within twice the tolerance in the tree's metric
+    const std::size_t radius = 2 * tolerance;
+    const ArgumentBase* best = nullptr;
+    std::size_t bestDistance = tolerance + 1;
+    suggestionPending_.assign(1, 0);
+    while (!suggestionPending_.empty()) {
+      const SuggestionNode& node = suggestionTree_[suggestionPending_.back()];
+      suggestionPending_.pop_back();
+
+      // Past the farthest edge plus the radius every child is pruned, so the
+      // exact distance is not needed beyond that bound
+      std::size_t farthestEdge = 0;
+      for (const auto& child : node.children) {
+        farthestEdge = std::max(farthestEdge, child.first);
+      }
+      const std::string_view candidate = node.argument->getNameView();
+      const std::size_t distance =
+          detail::editDistance(name, candidate, farthestEdge + radius,
+                               suggestionRows_, /*transpositions=*/false);
+      if (distance <= radius) {
+        const std::size_t alignment = detail::editDistance(
+            name, candidate, tolerance, suggestionRows_);
+        if (alignment < bestDistance ||
+            (alignment == bestDistance && best != nullptr &&
+             candidate < best->getNameView())) {
+          best = node.argument;
+          bestDistance = alignment;
+        }
+      }
+      for (const auto& child : node.children) {
+        if (child.first + radius >= distance &&
+            child.first <= distance + radius) {
+          suggestionPending_.push_back(child.second);
+        }
+      }
+    }
+    return best;
+  }
 
- public:
   /**
-   * @brief Construct a new Argument object for 64-bit integer values
-   *
-   * @param name The long name of the argument (e.g., "count")
-   * @param shortName The short name of the argument (e.g., "c")
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
-   * @param defaultValue The default value for this argument (default: 0)
+   * @brief Build the BK-tree over long names if arguments were added
    */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool required = false,
-           int64_t defaultValue = 0)
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {}
+  void buildSuggestionTree() {
+    if (!suggestionTreeDirty_) {
+      return;
+    }
+    suggestionTree_.clear();
+    suggestionTree_.reserve(longNameMap_.size());
+    for (const auto& entry : longNameMap_) {
+      const ArgumentBase* argument = entry.second;
+      if (suggestionTree_.empty()) {
+        suggestionTree_.push_back(SuggestionNode{argument, {}});
+        continue;
+      }
+      std::size_t nodeIndex = 0;
+      for (;;) {
+        const std::string_view nodeName =
+            suggestionTree_[nodeIndex].argument->getNameView();
+        const std::size_t distance = detail::editDistance(
+            entry.first, nodeName,
+            std::max(entry.first.size(), nodeName.size()), suggestionRows_,
+            /*transpositions=*/false);
+        if (distance == 0) {
+          break;  // Same name registered twice
+        }
+        auto& children = suggestionTree_[nodeIndex].children;
+        auto child = std::find_if(
+            children.begin(), children.end(),
+            [distance](const auto& edge) { return edge.first == distance; });
+        if (child != children.end()) {
+          nodeIndex = child->second;
+          continue;
+        }
+        children.emplace_back(distance, suggestionTree_.size());
+        suggestionTree_.push_back(SuggestionNode{argument, {}});
+        break;
+      }
+    }
+    suggestionTreeDirty_ = false;
+  }
 
   /**
-   * @brief Set a validator function for this argument
+   * @brief Find the closest subcommand name for an unknown subcommand
    *
-   * The validator function will be called during parsing to validate the value.
-   * @param validator The validator function to use
+   * @param name The unknown subcommand name
+   * @return The closest subcommand within detail::suggestionTolerance, or
+   * nullptr if there is none
    */
-  void setValidator(const Validator& validator) { validator_ = validator; }
+  [[nodiscard]] const Subcommand* suggestSubcommand(
+      std::string_view name) const {
+    const std::size_t tolerance = detail::suggestionTolerance(name);
+    const Subcommand* best = nullptr;
+    std::size_t bestDistance = tolerance + 1;
+    for (std::size_t i = 0; i < subcommandCount_; ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const Subcommand& command = subcommands_[i];
+      const std::size_t distance =
+          detail::editDistance(name, command.name, tolerance);
+      if (distance < bestDistance) {
+        best = &command;
+        bestDistance = distance;
+      }
+    }
+    return best;
+  }
 
   /**
-   * @brief Parse a string value into a 64-bit integer
+   * @brief Find the option that expects a value after a command-line word
    *
-   * @param value The string value to parse
-   * @return true if parsing and validation were successful, false otherwise
+   * @param word A word such as "--mode" or "-m"
+   * @return The non-flag option named by the word, or nullptr
    */
-  bool parse(const std::string& value) override {
-    char* end = nullptr;
-    errno = 0;  // Reset errno before calling strtoll
-    constexpr auto radix = 10;
-    const long long parsedValue = std::strtoll(value.c_str(), &end, radix);
-
-    // Check if the entire string was consumed
-    if (*end != '\0') {
-      return false;
+  [[nodiscard]] const ArgumentBase* optionTakingValue(
+      std::string_view word) const {
+    const ArgumentBase* argument = nullptr;
+    if (word.size() > 2 && word.substr(0, 2) == "--") {
+      auto it = longNameMap_.find(word.substr(2));
+      argument = it == longNameMap_.end() ? nullptr : it->second;
+    } else if (word.size() == 2 && word[0] == '-') {
+      auto it = shortNameMap_.find(word.substr(1));
+      argument = it == shortNameMap_.end() ? nullptr : it->second;
     }
+    if (argument == nullptr || isFlag(argument)) {
+      return nullptr;
+    }
+    return argument;
+  }
 
-    // Check for overflow/underflow
-    if (errno == ERANGE || parsedValue > INT64_MAX || parsedValue < INT64_MIN) {
-      return false;
+  /**
+   * @brief Print completion candidates for a list of words
+   *
+   * @param wordCount The number of words (the last one is being completed)
+   * @param words The words following `--__complete`
+   * @param os The output stream to print to
+   */ // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  void completeWords(int wordCount, char** words, std::ostream& os) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const std::string_view partial =
+        wordCount > 0 ? std::string_view(words[wordCount - 1]) : "";
+
+    // A subcommand in the context hands completion over to its parser
+    for (int i = 0; i + 1 < wordCount; ++i) {
+      const Subcommand* command = findSubcommand(words[i]);
+      if (command != nullptr) {
+        Parser child(programName_ + " " + command->name, command->description);
+        command->registerArguments(child);
+        child.completeWords(wordCount - i - 1, words + i + 1, os);
+        return;
+      }
     }
 
-    value_ = static_cast<int64_t>(parsedValue);
+    // Completing the value of "--option <partial>" or "--option=<partial>"
+    // (bash splits the latter into "--option", "=", "<partial>")
+    std::string_view previous =
+        wordCount >= 2 ? std::string_view(words[wordCount - 2]) : "";
+    if (previous == "=" && wordCount >= 3) {
+      previous = words[wordCount - 3];
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (const ArgumentBase* option = optionTakingValue(previous)) {
+      option->printChoices(partial, os);
+      return;
+    }
+    const std::size_t equal = partial.find('=');
+    if (partial.substr(0, 2) == "--" && equal != std::string_view::npos) {
+      if (const ArgumentBase* option =
+              optionTakingValue(partial.substr(0, equal))) {
+        std::ostringstream choices;
+        option->printChoices(partial.substr(equal + 1), choices);
+        const std::string text = choices.str();
+        std::string_view rest(text);
+        for (std::size_t end = rest.find('\n'); end != std::string_view::npos;
+             end = rest.find('\n')) {
+          os << partial.substr(0, equal + 1) << rest.substr(0, end) << "\n";
+          rest.remove_prefix(end + 1);
+        }
+      }
+      return;
+    }
 
-    if (validator_ && !validator_(value_)) {
-      return false;
+    // Long option names
+    if (partial.empty() || partial[0] == '-') {
+      const std::string_view prefix =
+          partial.size() >= 2 ? partial.substr(2) : std::string_view();
+      if (partial.size() < 2 || partial[1] == '-') {
+        ensureNameIndex();
+        for (auto it = nameLowerBound(prefix);
+             it != nameIndex_.end() &&
+             (*it)->getNameView().substr(0, prefix.size()) == prefix;
+             ++it) {
+          os << "--" << (*it)->getNameView() << "\n";
+        }
+        if (std::string_view("help").substr(0, prefix.size()) == prefix) {
+          os << "--help\n";
+        }
+      }
     }
 
-    isSet_ = true;
-    return true;
+    // Subcommand names
+    if (subcommandCount_ > 0 && (partial.empty() || partial[0] != '-')) {
+      for (std::size_t position = subcommandLowerBound(partial);
+           position < subcommandCount_ &&
+           std::string_view(subcommandAt(position).name)
+                   .substr(0, partial.size()) == partial;
+           ++position) {
+        os << subcommandAt(position).name << "\n";
+      }
+    }
   }
 
   /**
-   * @brief Get the parsed value of this argument
-   *
-   * @return int64_t The parsed value
+   * @brief Get the shell function name used by the completion scripts
+   * @return "_<program>_complete" with non-identifier characters replaced
    */
-  [[nodiscard]] int64_t getValue() const { return value_; }
+  [[nodiscard]] std::string completionFunctionName() const {
+    std::string function = "_";
+    for (const char c : programName_) {
+      const bool isWordChar = (c >= 'a' && c <= 'z') ||
+                              (c >= 'A' && c <= 'Z') ||
+                              (c >= '0' && c <= '9') || c == '_';
+      function += isWordChar ? c : '_';
+    }
+    return function + "_complete";
+  }
 
- protected:
   /**
-   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
-   * @return The type name or empty string if no type name should be displayed
+   * @brief Check whether the rest of a config line is blank or a comment
+   * @param rest The text following a complete token
+   * @return true if nothing meaningful follows, false otherwise
    */
-  [[nodiscard]] std::string getTypeName() const override {
-    return "(64-bit integer)";
+  static bool isTrailingComment(std::string_view rest) {
+    rest = detail::trimBlanks(rest);
+    return rest.empty() || rest.front() == '#' || rest.front() == ';';
   }
 
   /**
-   * @brief Get the default value as a string
-   * @return String representation of the default value or empty string if no
-   * default
+   * @brief Record a config error and format it into the last error message
+   *
+   * @param sourceName The config source name (usually the file path)
+   * @param line The 1-based line number
+   * @param column The 1-based column number
+   * @param message Description of the problem
+   * @return ParseResult Always INVALID_VALUE
    */
-  [[nodiscard]] std::string getDefaultString() const override {
-    return std::to_string(value_);
+  ParseResult configFailure(std::string_view sourceName, std::size_t line,
+                            std::size_t column, std::string message) {
+    configError_ = ConfigError{line, column, std::move(message)};
+    lastError_.assign(sourceName.data(), sourceName.size());
+    lastError_ += ":" + std::to_string(line) + ":" + std::to_string(column) +
+                  ": " + configError_.message;
+    return ParseResult::INVALID_VALUE;
   }
 
   /**
-   * @brief Check if the argument has a default value that should be displayed
-   * @return true if a default value should be shown, false otherwise
+   * @brief Apply bound environment variables in a single pass over envp
+   *
+   * Each "NAME=value" entry is looked up in the environment name index, so the
+   * cost is proportional to the size of the environment rather than to the
+   * number of bindings times the size of the environment.
+   * @param envp A null-terminated array of "NAME=value" strings
+   * @return ParseResult SUCCESS or INVALID_VALUE
    */
-  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0; }
+  ParseResult parseEnvironment(char** envp) {
+    std::size_t remaining = envNameMap_.size();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (char** entry = envp; *entry != nullptr && remaining > 0; ++entry) {
+      const char* text = *entry;
+      const char* equal = std::strchr(text, '=');
+      if (equal == nullptr) {
+        continue;
+      }
+
+      auto it = envNameMap_.find(
+          std::string_view(text, static_cast<std::size_t>(equal - text)));
+      if (it == envNameMap_.end()) {
+        continue;
+      }
+      ArgumentBase* argument = it->second;
+      if (argument->getSource() > ValueSource::ENVIRONMENT) {
+        --remaining;
+        continue;
+      }
+
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const char* value = equal + 1;
+      if (!argument->parseView(value)) {
+        lastError_ = std::string("Invalid value for environment variable: ") +
+                     it->first + " = " + value;
+        return ParseResult::INVALID_VALUE;
+      }
+      markSet(argument, ValueSource::ENVIRONMENT);
+      --remaining;
+    }
+    return ParseResult::SUCCESS;
+  }
 };
 
 /**
- * @brief Specialization for single-precision floating-point arguments
+ * @brief Values produced by FrozenSchema::parse()
  *
- * This specialization handles single-precision floating-point arguments, which
- * require conversion from string to float during parsing.
+ * Values are kept as text views into argv or into the schema (for defaults)
+ * and converted on access by FrozenSchema::getValue().
  */
-template <>
-class Argument<float> : public ArgumentBase {
+class SchemaValues {
+ private:
+  std::vector<std::string_view> text_;  // Value text per record
+  detail::BitVector set_;               // Records given on the command line
+  std::string lastError_;
+
  public:
   /**
-   * @brief Validator function type for single-precision floating-point
-   * arguments
-   *
-   * A validator is a function that takes a float value and returns
-   * true if the value is valid, false otherwise.
+   * @brief Clear all values for a schema with a number of records
+   * @param count The number of options plus positional arguments
    */
-  using Validator = std::function<bool(float)>;
+  void reset(std::size_t count) {
+    text_.assign(count, std::string_view());
+    set_ = detail::BitVector();
+    set_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      set_.pushBack(false);
+    }
+    lastError_.clear();
+  }
 
- private:
-  float value_;
-  Validator validator_;
+  /**
+   * @brief Record a value given on the command line (used by the schema)
+   * @param index The record index
+   * @param text The value text
+   */
+  void assign(std::size_t index, std::string_view text) {
+    text_[index] = text;
+    set_.set(index);
+  }
 
- public:
   /**
-   * @brief Construct a new Argument object for single-precision floating-point
-   * values
-   *
-   * @param name The long name of the argument (e.g., "rate")
-   * @param shortName The short name of the argument (e.g., "r")
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
-   * @param defaultValue The default value for this argument (default: 0.0f)
+   * @brief Check whether a record received a value on the command line
+   * @param index The record index
+   * @return true if the value was given, false otherwise
    */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool required = false,
-           float defaultValue = 0.0F)
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {}
+  [[nodiscard]] bool isSet(std::size_t index) const {
+    return index < set_.size() && set_.test(index);
+  }
 
   /**
-   * @brief Set a validator function for this argument
-   *
-   * The validator function will be called during parsing to validate the value.
-   * @param validator The validator function to use
+   * @brief Get the text given for a record
+   * @param index The record index
+   * @return The value text, or an empty view if none was given
    */
-  void setValidator(const Validator& validator) { validator_ = validator; }
+  [[nodiscard]] std::string_view getText(std::size_t index) const {
+    return index < text_.size() ? text_[index] : std::string_view();
+  }
 
   /**
-   * @brief Parse a string value into a single-precision floating-point number
-   *
-   * @param value The string value to parse
-   * @return true if parsing and validation were successful, false otherwise
-   * @note Handles scientific notation (e.g., 1e-5, 2.5E+3) and standard
-   * decimal formats.
+   * @brief Get the error message of the last failed parse
+   * @return const std::string& The message, empty after a successful parse
    */
-  bool parse(const std::string& value) override {
-    char* end = nullptr;
-    errno = 0;  // Reset errno before calling strtof
-    const float parsedValue = std::strtof(value.c_str(), &end);
+  [[nodiscard]] const std::string& getLastError() const { return lastError_; }
 
-    // Check if the entire string was consumed
-    if (*end != '\0') {
-      return false;
-    }
+  /**
+   * @brief Set the error message (used by the schema)
+   * @param message The message
+   */
+  void setLastError(std::string message) { lastError_ = std::move(message); }
+};
 
-    // Check for overflow/underflow (strtof sets errno to ERANGE)
-    if (errno == ERANGE) {
-      return false;
-    }
+/**
+ * @brief Read-only schema loaded from a blob written by
+ * Parser::freezeSchema()
+ *
+ * Loading maps the file (or attaches to caller-owned memory) and checks the
+ * header in constant time: no argument objects, maps or strings are built.
+ * Index entries are bounds-checked when a lookup reaches them.
+ * Names are looked up by binary search in the blob's sorted indexes, and
+ * values are converted with convertValue(), like Argument<T> does. Validators,
+ * environment variables, config files and subcommands are not supported.
+ */
+class FrozenSchema {
+ public:
+  /// Returned by find() and findShort() when no option matches
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
-    value_ = parsedValue;
+  /// Blob layout version; blobs with another version are rejected
+  static constexpr std::uint32_t kVersion = detail::kFrozenVersion;
 
-    if (validator_ && !validator_(value_)) {
-      return false;
+ private:
+  std::unique_ptr<detail::MappedFile> file_;
+  const char* data_{nullptr};
+  detail::FrozenHeader header_;
+  std::size_t longIndexOffset_{0};
+  std::size_t shortIndexOffset_{0};
+  std::size_t poolOffset_{0};
+  std::string lastError_;
+
+  [[nodiscard]] detail::FrozenRecord record(std::size_t index) const {
+    return detail::loadBytes<detail::FrozenRecord>(
+        data_, sizeof(detail::FrozenHeader) +
+                   index * sizeof(detail::FrozenRecord));
+  }
+
+  [[nodiscard]] std::string_view text(detail::FrozenString entry) const {
+    if (std::size_t{entry.offset} + entry.size > header_.stringBytes) {
+      return {};
     }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return {data_ + poolOffset_ + entry.offset, entry.size};
+  }
 
-    isSet_ = true;
-    return true;
+  [[nodiscard]] std::size_t search(std::size_t offset, std::size_t count,
+                                   std::string_view name) const {
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+      const std::size_t middle = low + (high - low) / 2;
+      const auto entry = detail::loadBytes<detail::FrozenIndexEntry>(
+          data_, offset + middle * sizeof(detail::FrozenIndexEntry));
+      const int order = text(entry.name).compare(name);
+      if (order == 0) {
+        // Checked here rather than in attach(), which stays constant time
+        return entry.record < header_.optionCount ? entry.record : npos;
+      }
+      if (order < 0) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return npos;
   }
 
-  /**
-   * @brief Get the parsed value of this argument
-   *
-   * @return float The parsed value
-   */
-  [[nodiscard]] float getValue() const { return value_; }
+  [[nodiscard]] std::size_t recordCount() const {
+    return std::size_t{header_.optionCount} + header_.positionalCount;
+  }
 
- protected:
   /**
-   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
-   * @return The type name or empty string if no type name should be displayed
+   * @brief Check that a value converts to a record's type
    */
-  [[nodiscard]] std::string getTypeName() const override { return "(float)"; }
+  [[nodiscard]] bool convertible(std::size_t index,
+                                 std::string_view value) const {
+    switch (getType(index)) {
+      case ArgumentType::BOOL:
+        return converts<bool>(value);
+      case ArgumentType::STRING:
+        return true;
+      case ArgumentType::INT16:
+        return converts<int16_t>(value);
+      case ArgumentType::UINT32:
+        return converts<uint32_t>(value);
+      case ArgumentType::INT32:
+        return converts<int32_t>(value);
+      case ArgumentType::UINT64:
+        return converts<uint64_t>(value);
+      case ArgumentType::INT64:
+        return converts<int64_t>(value);
+      case ArgumentType::FLOAT:
+        return converts<float>(value);
+      case ArgumentType::DOUBLE:
+        break;
+    }
+    return converts<double>(value);
+  }
+
+  template <typename T>
+  static bool converts(std::string_view value) {
+    T parsedValue{};
+    return convertValue(value, parsedValue);
+  }
 
   /**
-   * @brief Format a float value to a string without trailing zeros
-   * @param value The float value to format
-   * @return Formatted string representation
+   * @brief Lookups and stores of parse() for detail::tokenizeArguments()
    */
-  static std::string formatFloat(float value) {
-    constexpr size_t size = 32;
-    std::array<char, size> buffer{};
-    int len = std::snprintf(buffer.data(), buffer.size(), "%.6g", value);
-    if (len < 0 || static_cast<std::size_t>(len) >= buffer.size()) {
-      // Fallback to scientific notation if buffer is too small
-      len = std::snprintf(buffer.data(), buffer.size(), "%.6e", value);
-      if (len < 0 || static_cast<std::size_t>(len) >= buffer.size()) {
-        return std::string{};
+  struct CommandLineHooks {
+    using Key = std::size_t;  ///< Record index, or npos
+
+    const FrozenSchema& schema;
+    SchemaValues& values;
+    /// Number of positional values seen (may exceed the stored count)
+    std::size_t positionalCount{0};
+
+    [[nodiscard]] static bool done() { return false; }
+
+    [[nodiscard]] Key findShort(std::string_view name) const {
+      return schema.findShort(name);
+    }
+
+    [[nodiscard]] bool isFlag(Key key) const {
+      return key != npos && schema.getType(key) == ArgumentType::BOOL;
+    }
+
+    [[nodiscard]] bool takesValue(Key key) const {
+      return key != npos && schema.getType(key) != ArgumentType::BOOL;
+    }
+
+    ParseResult positional(int /*index*/, std::string_view arg,
+                           bool /*optionsEnded*/) {
+      if (positionalCount < schema.header_.positionalCount) {
+        const std::size_t index = schema.header_.optionCount + positionalCount;
+        if (!schema.convertible(index, arg)) {
+          values.setLastError("Invalid value for positional argument: " +
+                              std::string(schema.getName(index)) + " = " +
+                              std::string(arg));
+          return ParseResult::INVALID_VALUE;
+        }
+        values.assign(index, arg);
       }
+      ++positionalCount;
+      return ParseResult::SUCCESS;
     }
-    return {buffer.begin(), buffer.begin() + len};
-  }
+
+    ParseResult lookup(const detail::OptionToken& token, Key& key) const {
+      key = token.isLong ? schema.find(token.name)
+                         : schema.findShort(token.name);
+      return ParseResult::SUCCESS;
+    }
+
+    ParseResult unknown(const detail::OptionToken& token) {
+      values.setLastError(std::string("Unknown option: ") + token.dashes() +
+                          std::string(token.name));
+      return ParseResult::UNKNOWN_OPTION;
+    }
+
+    ParseResult flag(const detail::OptionToken& /*token*/, Key key) {
+      values.assign(key, "true");
+      return ParseResult::SUCCESS;
+    }
+
+    ParseResult missingValue(const detail::OptionToken& token) {
+      values.setLastError(std::string("Missing value for option: ") +
+                          token.dashes() + std::string(token.name));
+      return ParseResult::MISSING_VALUE;
+    }
+
+    ParseResult store(const detail::OptionToken& token, Key key) {
+      if (!schema.convertible(key, token.value)) {
+        values.setLastError(std::string("Invalid value for option: ") +
+                            token.dashes() + std::string(token.name) +
+                            " = " + std::string(token.value));
+        return ParseResult::INVALID_VALUE;
+      }
+      values.assign(key, token.value);
+      return ParseResult::SUCCESS;
+    }
+  };
+
+ public:
+  FrozenSchema() = default;
 
   /**
-   * @brief Get the default value as a string
-   * @return String representation of the default value or empty string if no
-   * default
+   * @brief Map a schema file
+   *
+   * @param path The file written from Parser::freezeSchema()
+   * @param expectedHash The hash the program was built against (see
+   * getHash()), or 0 to accept any schema
+   * @return true on success; false if the file cannot be read, is not a
+   * schema of this version, is truncated or has another hash, with the
+   * reason in getLastError()
    */
-  [[nodiscard]] std::string getDefaultString() const override {
-    return Argument<float>::formatFloat(value_);
+  bool load(const char* path, std::uint64_t expectedHash = 0) {
+    auto file = std::make_unique<detail::MappedFile>(path);
+    if (!file->isOpen()) {
+      lastError_ = std::string("Cannot open schema: ") + path;
+      return false;
+    }
+    if (!attach(file->contents(), expectedHash)) {
+      return false;
+    }
+    file_ = std::move(file);
+    return true;
   }
 
   /**
-   * @brief Check if the argument has a default value that should be displayed
-   * @return true if a default value should be shown, false otherwise
+   * @brief Use a schema blob in caller-owned memory (e.g., embedded data)
+   *
+   * @param blob The blob; must stay valid while the schema is used
+   * @param expectedHash The hash the program was built against, or 0 to
+   * accept any schema
+   * @return true on success, false otherwise (see getLastError())
    */
-  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0.0F; }
-};
+  bool attach(std::string_view blob, std::uint64_t expectedHash = 0) {
+    data_ = nullptr;
+    file_.reset();
+    if (blob.size() < sizeof(detail::FrozenHeader)) {
+      lastError_ = "Truncated schema";
+      return false;
+    }
+    const auto header = detail::loadBytes<detail::FrozenHeader>(blob.data(), 0);
+    if (header.magic != detail::kFrozenMagic) {
+      lastError_ = "Not an argsparser schema";
+      return false;
+    }
+    if (header.version != kVersion) {
+      lastError_ = "Unsupported schema version: " +
+                   std::to_string(header.version);
+      return false;
+    }
+    const std::size_t records =
+        std::size_t{header.optionCount} + header.positionalCount;
+    const std::size_t longIndex =
+        sizeof(header) + records * sizeof(detail::FrozenRecord);
+    const std::size_t shortIndex =
+        longIndex + header.longIndexCount * sizeof(detail::FrozenIndexEntry);
+    const std::size_t pool =
+        shortIndex + header.shortIndexCount * sizeof(detail::FrozenIndexEntry);
+    if (pool + header.stringBytes != blob.size()) {
+      lastError_ = "Truncated schema";
+      return false;
+    }
+    if (expectedHash != 0 && header.hash != expectedHash) {
+      lastError_ = "Stale schema: hash does not match the program";
+      return false;
+    }
+    header_ = header;
+    longIndexOffset_ = longIndex;
+    shortIndexOffset_ = shortIndex;
+    poolOffset_ = pool;
+    data_ = blob.data();
+    lastError_.clear();
+    return true;
+  }
 
-/**
- * @brief Specialization for double-precision floating-point arguments
- *
- * This specialization handles double-precision floating-point arguments, which
- * require conversion from string to double during parsing.
- */
-template <>
-class Argument<double> : public ArgumentBase {
- public:
   /**
-   * @brief Validator function type for double-precision floating-point
-   * arguments
+   * @brief Recompute the hash over the whole blob
    *
-   * A validator is a function that takes a double value and returns
-   * true if the value is valid, false otherwise.
+   * load() and attach() only check the header; call this for blobs from
+   * untrusted storage. It also checks that every index entry names an
+   * option.
+   * @return true if the contents match the stored hash and the indexes are
+   * in range
    */
-  using Validator = std::function<bool(double)>;
+  [[nodiscard]] bool verify() const {
+    if (data_ == nullptr) {
+      return false;
+    }
+    for (std::size_t offset = longIndexOffset_; offset < poolOffset_;
+         offset += sizeof(detail::FrozenIndexEntry)) {
+      const auto entry =
+          detail::loadBytes<detail::FrozenIndexEntry>(data_, offset);
+      if (entry.record >= header_.optionCount) {
+        return false;
+      }
+    }
+    const std::size_t size = poolOffset_ + header_.stringBytes;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const std::string_view payload(data_ + sizeof(header_),
+                                   size - sizeof(header_));
+    return detail::fnv1a(payload) == header_.hash;
+  }
 
- private:
-  double value_;
-  Validator validator_;
+  /**
+   * @brief Get the last load error
+   * @return const std::string& The message, empty after a successful load
+   */
+  [[nodiscard]] const std::string& getLastError() const { return lastError_; }
 
- public:
   /**
-   * @brief Construct a new Argument object for double-precision floating-point
-   * values
-   *
-   * @param name The long name of the argument (e.g., "precision")
-   * @param shortName The short name of the argument (e.g., "p")
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
-   * @param defaultValue The default value for this argument (default: 0.0)
+   * @brief Get the schema hash, to be compiled into the program as the
+   * expected hash
+   * @return std::uint64_t The FNV-1a hash of the blob contents
+   */
+  [[nodiscard]] std::uint64_t getHash() const { return header_.hash; }
+
+  /**
+   * @brief Get the number of options
+   * @return std::size_t The count; options are records [0, count)
    */
-  Argument(const std::string& name, const std::string& shortName,
-           const std::string& description, bool required = false,
-           double defaultValue = 0.0)
-      : ArgumentBase(name, shortName, description, required),
-        value_(defaultValue) {}
+  [[nodiscard]] std::size_t optionCount() const { return header_.optionCount; }
 
   /**
-   * @brief Set a validator function for this argument
-   *
-   * The validator function will be called during parsing to validate the value.
-   * @param validator The validator function to use
+   * @brief Get the number of positional arguments
+   * @return std::size_t The count; positional i is record optionCount() + i
    */
-  void setValidator(const Validator& validator) { validator_ = validator; }
+  [[nodiscard]] std::size_t positionalCount() const {
+    return header_.positionalCount;
+  }
 
   /**
-   * @brief Parse a string value into a double-precision floating-point number
-   *
-   * @param value The string value to parse
-   * @return true if parsing and validation were successful, false otherwise
-   * @note Handles scientific notation (e.g., 1e-5, 2.5E+3) and standard
-   * decimal formats.
+   * @brief Find an option by long name
+   * @param name The long name, without "--"
+   * @return std::size_t The record index, or npos
    */
-  bool parse(const std::string& value) override {
-    char* end = nullptr;
-    errno = 0;  // Reset errno before calling strtod
-    const double parsedValue = std::strtod(value.c_str(), &end);
+  [[nodiscard]] std::size_t find(std::string_view name) const {
+    return search(longIndexOffset_, header_.longIndexCount, name);
+  }
 
-    // Check if the entire string was consumed
-    if (*end != '\0') {
-      return false;
-    }
+  /**
+   * @brief Find an option by short name
+   * @param name The short name, without "-"
+   * @return std::size_t The record index, or npos
+   */
+  [[nodiscard]] std::size_t findShort(std::string_view name) const {
+    return search(shortIndexOffset_, header_.shortIndexCount, name);
+  }
 
-    // Check for overflow/underflow (strtod sets errno to ERANGE)
-    if (errno == ERANGE) {
-      return false;
-    }
+  /**
+   * @brief Get the value type of a record
+   * @param index The record index
+   * @return ArgumentType The type tag
+   */
+  [[nodiscard]] ArgumentType getType(std::size_t index) const {
+    return static_cast<ArgumentType>(record(index).type);
+  }
 
-    value_ = parsedValue;
+  /**
+   * @brief Get the name of a record
+   * @param index The record index
+   * @return std::string_view The name, pointing into the blob
+   */
+  [[nodiscard]] std::string_view getName(std::size_t index) const {
+    return text(record(index).name);
+  }
 
-    if (validator_ && !validator_(value_)) {
-      return false;
-    }
+  /**
+   * @brief Get the short name of a record
+   * @param index The record index
+   * @return std::string_view The short name, or "" if there is none
+   */
+  [[nodiscard]] std::string_view getShortName(std::size_t index) const {
+    return text(record(index).shortName);
+  }
 
-    isSet_ = true;
-    return true;
+  /**
+   * @brief Get the description of a record
+   * @param index The record index
+   * @return std::string_view The description
+   */
+  [[nodiscard]] std::string_view getDescription(std::size_t index) const {
+    return text(record(index).description);
   }
 
   /**
-   * @brief Get the parsed value of this argument
-   *
-   * @return double The parsed value
+   * @brief Get the default value of a record in command-line syntax
+   * @param index The record index
+   * @return std::string_view The default, or "" for the type's zero value
    */
-  [[nodiscard]] double getValue() const { return value_; }
+  [[nodiscard]] std::string_view getDefault(std::size_t index) const {
+    return text(record(index).defaultValue);
+  }
 
- protected:
   /**
-   * @brief Get the type name for this argument (e.g., "(integer)", "(float)")
-   * @return The type name or empty string if no type name should be displayed
+   * @brief Check whether a record must be given
+   * @param index The record index
+   * @return true if the option or positional argument is required
    */
-  [[nodiscard]] std::string getTypeName() const override { return "(double)"; }
+  [[nodiscard]] bool isRequired(std::size_t index) const {
+    return (record(index).flags & detail::kFrozenRequired) != 0;
+  }
 
   /**
-   * @brief Format a double value to a string without trailing zeros
-   * @param value The double value to format
-   * @return Formatted string representation
+   * @brief Print the help text rendered when the schema was frozen
+   * @param os The output stream to print to (default: std::cout)
    */
-  static std::string formatDouble(double value) {
-    constexpr size_t size = 32;
-    std::array<char, size> buffer{};
-    int len = std::snprintf(buffer.data(), buffer.size(), "%.15g", value);
-    if (len < 0 || static_cast<std::size_t>(len) >= buffer.size()) {
-      // Fallback to scientific notation if buffer is too small
-      len = std::snprintf(buffer.data(), buffer.size(), "%.15e", value);
-      if (len < 0 || static_cast<std::size_t>(len) >= buffer.size()) {
-        return std::string{};
+  void printHelp(std::ostream& os = std::cout) const {
+    os << text(header_.help);
+  }
+
+  /**
+   * @brief Parse command-line arguments against the schema
+   *
+   * Accepts the same syntax as Parser::parse(): --name value, --name=value,
+   * -n value, -nvalue, grouped short flags, positional arguments and "--"
+   * to end the options.
+   * @param argc The number of command-line arguments
+   * @param argv The array of command-line argument strings; the values refer
+   * to it, so it must outlive them
+   * @param values Receives the values (and the error message on failure)
+   * @return ParseResult The result of the parsing operation
+   */
+  ParseResult parse(int argc, char** argv, SchemaValues& values) const {
+    ARGSPARSER_ALLOCATION_PHASE(PARSE);
+    values.reset(recordCount());
+    if (detail::helpRequested(argc, argv,
+                              [](std::string_view) { return false; })) {
+      return ParseResult::HELP_REQUESTED;
+    }
+
+    CommandLineHooks hooks{*this, values};
+    const ParseResult result = detail::tokenizeArguments(argc, argv, hooks);
+    if (result != ParseResult::SUCCESS) {
+      return result;
+    }
+    if (hooks.positionalCount > header_.positionalCount) {
+      values.setLastError("Too many positional arguments");
+      return ParseResult::INVALID_VALUE;
+    }
+    for (std::size_t index = 0; index < recordCount(); ++index) {
+      if (!values.isSet(index) && isRequired(index)) {
+        values.setLastError(
+            std::string(index < header_.optionCount
+                            ? "Missing required option: --"
+                            : "Missing required positional argument: ") +
+            std::string(getName(index)));
+        return ParseResult::MISSING_VALUE;
       }
     }
-    return {buffer.begin(), buffer.begin() + len};
+    return ParseResult::SUCCESS;
   }
 
   /**
-   * @brief Get the default value as a string
-   * @return String representation of the default value or empty string if no
-   * default
+   * @brief Get the value of an option or positional argument
+   *
+   * @tparam T The value type; must match the record's type
+   * @param values The result of parse()
+   * @param name The long name of an option or the name of a positional
+   * argument
+   * @return T The given value, else the default, else T{} (also for unknown
+   * names and mismatched types)
    */
-  [[nodiscard]] std::string getDefaultString() const override {
-    return Argument<double>::formatDouble(value_);
+  template <typename T>
+  [[nodiscard]] T getValue(const SchemaValues& values,
+                           std::string_view name) const {
+    std::size_t index = find(name);
+    for (std::size_t i = 0; index == npos && i < header_.positionalCount;
+         ++i) {
+      if (getName(header_.optionCount + i) == name) {
+        index = header_.optionCount + i;
+      }
+    }
+    if (index == npos || getType(index) != detail::ArgumentTypeOf<T>::value) {
+      return T{};
+    }
+    const std::string_view text =
+        values.isSet(index) ? values.getText(index) : getDefault(index);
+    T value{};
+    if (!text.empty()) {
+      static_cast<void>(convertValue(text, value));
+    }
+    return value;
   }
 
   /**
-   * @brief Check if the argument has a default value that should be displayed
-   * @return true if a default value should be shown, false otherwise
+   * @brief Check whether an option or positional argument was given
+   * @param values The result of parse()
+   * @param name The long name of an option or the name of a positional
+   * argument
+   * @return true if it was given on the command line
    */
-  [[nodiscard]] bool hasDefaultValue() const override { return value_ != 0.0; }
+  [[nodiscard]] bool isSet(const SchemaValues& values,
+                           std::string_view name) const {
+    const std::size_t index = find(name);
+    if (index != npos) {
+      return values.isSet(index);
+    }
+    for (std::size_t i = 0; i < header_.positionalCount; ++i) {
+      if (getName(header_.optionCount + i) == name) {
+        return values.isSet(header_.optionCount + i);
+      }
+    }
+    return false;
+  }
 };
 
 /**
- * @brief Print help information for this argument
- * @param os The output stream to print to
+ * @brief Base of the key types that declare a StaticParser schema
+ *
+ * A key derives from Key<T> and declares its name as a static constexpr
+ * member; `shortName`, `description`, `required`, `positional` and
+ * `defaultValue` are optional:
+ * @code
+ * struct Threads : argsparser::Key<int32_t> {
+ *   static constexpr std::string_view name = "threads";
+ *   static constexpr std::string_view shortName = "t";
+ *   static constexpr std::string_view description = "Worker threads";
+ *   static constexpr int32_t defaultValue = 4;
+ * };
+ * @endcode
+ * @tparam T The value type (one of the types addArgument() accepts)
  */
-inline void ArgumentBase::printHelp(std::ostream& os) const {
-  if (!shortName_.empty()) {
-    os << "  -" << shortName_ << ", --" << name_;
+template <typename T>
+struct Key {
+  using ValueType = T;
+};
+
+#if defined(__cpp_nontype_template_args) && \
+    __cpp_nontype_template_args >= 201911L
+/**
+ * @brief A string literal usable as a template argument (C++20)
+ *
+ * Lets StaticParser::get<"threads">() name a key by its option name.
+ */
+template <std::size_t N>
+struct FixedString {
+  std::array<char, N> chars{};
+
+  // NOLINTNEXTLINE(hicpp-explicit-conversions)
+  constexpr FixedString(const char (&text)[N]) {
+    for (std::size_t i = 0; i < N; ++i) {
+      chars[i] = text[i];  // NOLINT(cppcoreguidelines-pro-bounds-*)
+    }
+  }
+
+  [[nodiscard]] constexpr std::string_view view() const {
+    return std::string_view(chars.data(), N - 1);
+  }
+};
+#define ARGSPARSER_HAS_FIXED_STRING 1
+#else
+#define ARGSPARSER_HAS_FIXED_STRING 0
+#endif
+
+namespace detail {
+
+template <typename K, typename = void>
+struct KeyIsRequired : std::false_type {};
+template <typename K>
+struct KeyIsRequired<K, std::void_t<decltype(K::required)>>
+    : std::bool_constant<K::required> {};
+
+template <typename K, typename = void>
+struct KeyIsPositional : std::false_type {};
+template <typename K>
+struct KeyIsPositional<K, std::void_t<decltype(K::positional)>>
+    : std::bool_constant<K::positional> {};
+
+template <typename K, typename = void>
+struct KeyShortName {
+  static constexpr std::string_view value{};
+};
+template <typename K>
+struct KeyShortName<K, std::void_t<decltype(K::shortName)>> {
+  static constexpr std::string_view value = K::shortName;
+};
+
+template <typename K, typename = void>
+struct KeyDescription {
+  static constexpr std::string_view value{};
+};
+template <typename K>
+struct KeyDescription<K, std::void_t<decltype(K::description)>> {
+  static constexpr std::string_view value = K::description;
+};
+
+template <typename K, typename = void>
+struct KeyHasDefault : std::false_type {};
+template <typename K>
+struct KeyHasDefault<K, std::void_t<decltype(K::defaultValue)>>
+    : std::true_type {};
+
+/**
+ * @brief The default value of a key: K::defaultValue if declared, else T{}
+ */
+template <typename K>
+typename K::ValueType keyDefault() {
+  using T = typename K::ValueType;
+  if constexpr (KeyHasDefault<K>::value) {
+    return T(K::defaultValue);
   } else {
-    os << "  --" << name_;
+    return T{};
   }
-  if (isRequired_) {
-    os << " (required)";
+}
+
+/**
+ * @brief Position of key K in Keys, or sizeof...(Keys) if absent
+ */
+template <typename K, typename... Keys>
+constexpr std::size_t indexOfKey() {
+  constexpr std::array<bool, sizeof...(Keys)> matches{
+      std::is_same_v<K, Keys>...};
+  std::size_t index = 0;
+  while (index < matches.size() && !matches[index]) {
+    ++index;
   }
-  os << "\n    " << description_;
+  return index;
+}
 
-  // Add type name if applicable
-  const std::string typeName = getTypeName();
-  if (!typeName.empty()) {
-    os << " " << typeName;
+/**
+ * @brief Position of the key named name in Keys, or sizeof...(Keys)
+ */
+template <typename... Keys>
+constexpr std::size_t indexOfKeyName(std::string_view name) {
+  constexpr std::array<std::string_view, sizeof...(Keys)> names{
+      Keys::name...};
+  std::size_t index = 0;
+  while (index < names.size() && names[index] != name) {
+    ++index;
   }
+  return index;
+}
 
-  // Add default value if applicable
-  if (hasDefaultValue()) {
-    const std::string defaultStr = getDefaultString();
-    if (!defaultStr.empty()) {
-      os << " (default: " << defaultStr << ")";
+/**
+ * @brief Check that no two keys share a long or short name
+ */
+template <typename... Keys>
+constexpr bool keyNamesAreUnique() {
+  constexpr std::array<std::string_view, sizeof...(Keys)> names{
+      Keys::name...};
+  constexpr std::array<std::string_view, sizeof...(Keys)> shortNames{
+      KeyShortName<Keys>::value...};
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    for (std::size_t j = i + 1; j < names.size(); ++j) {
+      if (names[i] == names[j] ||
+          (!shortNames[i].empty() && shortNames[i] == shortNames[j])) {
+        return false;
+      }
     }
   }
-  os << "\n";
+  return true;
 }
 
+}  // namespace detail
+
 /**
- * @brief Main argument parser class
+ * @brief Parser whose schema is a list of key types fixed at compile time
  *
- * The Parser class is the primary interface for defining and parsing
- * command-line arguments. It manages a collection of arguments and
- * handles the parsing of command-line input.
+ * Values are read with get<Key>() (or get<"name">() in C++20). The key is
+ * resolved to a position in a tuple of argument pointers at compile time,
+ * so a read is two loads with no name lookup. A key that is not part of the
+ * schema, or a misspelled name, fails to compile instead of returning a
+ * default value at run time. Parsing, help, config files and environment
+ * bindings go through the wrapped Parser.
+ * @tparam Keys The key types, in registration (and help) order
  */
-class Parser {
+template <typename... Keys>
+class StaticParser {
+  static_assert(detail::keyNamesAreUnique<Keys...>(),
+                "StaticParser keys must have distinct long and short names");
+
  private:
-  std::string programName_;
-  std::string description_;
-  std::vector<std::unique_ptr<ArgumentBase>> arguments_;
-  std::map<std::string, ArgumentBase*> longNameMap_;
-  std::map<std::string, ArgumentBase*> shortNameMap_;
-  std::vector<std::unique_ptr<ArgumentBase>> positionalArguments_;
-  std::string lastError_;
+  Parser parser_;
+  std::tuple<Argument<typename Keys::ValueType>*...> arguments_;
+
+  template <typename K>
+  Argument<typename K::ValueType>* add() {
+    using T = typename K::ValueType;
+    if constexpr (detail::KeyIsPositional<K>::value) {
+      return parser_.addPositionalArgument<T>(
+          K::name, detail::KeyDescription<K>::value,
+          detail::KeyIsRequired<K>::value, detail::keyDefault<K>(),
+          StringStorage::REFERENCE);
+    } else {
+      return parser_.addArgument<T>(
+          K::name, detail::KeyShortName<K>::value,
+          detail::KeyDescription<K>::value, detail::KeyIsRequired<K>::value,
+          detail::keyDefault<K>(), StringStorage::REFERENCE);
+    }
+  }
 
  public:
   /**
-   * @brief Construct a new Parser object
+   * @brief Construct the parser and register every key
    *
    * @param programName The name of the program (used in help text)
    * @param description A description of the program (used in help text)
    */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters,hicpp-explicit-conversions)
-  Parser(const std::string& programName, const std::string& description = "")
-      : programName_(programName), description_(description) {}
+  StaticParser(const std::string& programName,
+               const std::string& description = "")
+      : parser_(programName, description),
+        arguments_{add<Keys>()...} {}  // Braces register left to right
 
   /**
-   * @brief Get the last error message
-   *
-   * @return const std::string& The last error message
+   * @brief Parse command-line arguments
+   * @param argc The number of command-line arguments
+   * @param argv The array of command-line argument strings
+   * @return ParseResult The result of Parser::parse()
    */
-  [[nodiscard]] const std::string& getLastError() const { return lastError_; }
+  ParseResult parse(int argc, char** argv) {
+    return parser_.parse(argc, argv);
+  }
 
   /**
-   * @brief Add a new argument to the parser
-   *
-   * @tparam T The type of the argument (e.g., bool, std::string, int)
-   * @param name The long name of the argument (e.g., "verbose")
-   * @param shortName The short name of the argument (e.g., "v")
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: false)
-   * @param defaultValue The default value for this argument (default: T{})
-   * @return Argument<T>* Pointer to the created argument
-   * @note The returned pointer is owned by the parser and should not be
-   * deleted.
+   * @brief Get the value of a key
+   * @tparam K A key type of this schema
+   * @return const K::ValueType& The value
    */
-  template <typename T>
-  Argument<T>* addArgument(const std::string& name,
-                           const std::string& shortName,
-                           const std::string& description,
-                           bool required = false, const T& defaultValue = T{}) {
-    auto arg = std::make_unique<Argument<T>>(name, shortName, description,
-                                             required, defaultValue);
-    Argument<T>* ptr = arg.get();
+  template <typename K>
+  [[nodiscard]] const typename K::ValueType& get() const {
+    constexpr std::size_t index = detail::indexOfKey<K, Keys...>();
+    static_assert(index < sizeof...(Keys),
+                  "Key is not part of this StaticParser schema");
+    return std::get<index>(arguments_)->getValue();
+  }
+
+  /**
+   * @brief Check whether a key received a value
+   * @tparam K A key type of this schema
+   * @return true if it was given on the command line, in the environment or
+   * in a config file
+   */
+  template <typename K>
+  [[nodiscard]] bool isSet() const {
+    constexpr std::size_t index = detail::indexOfKey<K, Keys...>();
+    static_assert(index < sizeof...(Keys),
+                  "Key is not part of this StaticParser schema");
+    return std::get<index>(arguments_)->isSet();
+  }
+
+#if ARGSPARSER_HAS_FIXED_STRING
+  /**
+   * @brief Get the value of the key with a given name (C++20)
+   * @tparam Name The key's long name, e.g. get<"threads">()
+   * @return The value, typed by the key
+   */
+  template <FixedString Name>
+  [[nodiscard]] const auto& get() const {
+    constexpr std::size_t index =
+        detail::indexOfKeyName<Keys...>(Name.view());
+    static_assert(index < sizeof...(Keys),
+                  "No key of this StaticParser schema has that name");
+    return std::get<index>(arguments_)->getValue();
+  }
+
+  /**
+   * @brief Check whether the key with a given name received a value (C++20)
+   * @tparam Name The key's long name, e.g. isSet<"threads">()
+   */
+  template <FixedString Name>
+  [[nodiscard]] bool isSet() const {
+    constexpr std::size_t index =
+        detail::indexOfKeyName<Keys...>(Name.view());
+    static_assert(index < sizeof...(Keys),
+                  "No key of this StaticParser schema has that name");
+    return std::get<index>(arguments_)->isSet();
+  }
+#endif
+
+  /**
+   * @brief Get the wrapped parser (errors, help, config files, environment)
+   * @return Parser& The parser
+   */
+  [[nodiscard]] Parser& parser() { return parser_; }
+
+  /**
+   * @brief Get the wrapped parser
+   * @return const Parser& The parser
+   */
+  [[nodiscard]] const Parser& parser() const { return parser_; }
+};
+
+/**
+ * @brief Error details of a parser generated by argsparser_generate
+ */
+struct GeneratedError {
+  const char* message{""};    ///< What went wrong (e.g., "Unknown option")
+  std::string_view argument;  ///< The option or value concerned
+};
+
+namespace detail {
+
+/**
+ * @brief Lookups and stores of parseGenerated() for tokenizeArguments()
+ */
+template <typename Spec>
+struct GeneratedHooks {
+  using Key = int;  ///< Field index, or -1
+
+  Spec& spec;
+  /// Number of positional values seen (may exceed kPositionalCount)
+  int positionalCount{0};
+
+  [[nodiscard]] static bool done() { return false; }
+
+  [[nodiscard]] static Key findShort(std::string_view name) {
+    return Spec::findShort(name);
+  }
+
+  [[nodiscard]] static bool isFlag(Key key) {
+    return key >= 0 && Spec::isFlag(key);
+  }
+
+  [[nodiscard]] static bool takesValue(Key key) {
+    return key >= 0 && !Spec::isFlag(key);
+  }
+
+  ParseResult fail(const char* message, std::string_view argument,
+                   ParseResult result) {
+    spec.error.message = message;
+    spec.error.argument = argument;
+    return result;
+  }
+
+  ParseResult positional(int /*index*/, std::string_view arg,
+                         bool /*optionsEnded*/) {
+    if (positionalCount < Spec::kPositionalCount &&
+        !spec.assign(Spec::kOptionCount + positionalCount, arg)) {
+      return fail("Invalid value for positional argument", arg,
+                  ParseResult::INVALID_VALUE);
+    }
+    ++positionalCount;
+    return ParseResult::SUCCESS;
+  }
+
+  static ParseResult lookup(const OptionToken& token, Key& key) {
+    key = token.isLong ? Spec::findLong(token.name)
+                       : Spec::findShort(token.name);
+    return ParseResult::SUCCESS;
+  }
+
+  ParseResult unknown(const OptionToken& token) {
+    return fail("Unknown option", token.word, ParseResult::UNKNOWN_OPTION);
+  }
+
+  ParseResult flag(const OptionToken& /*token*/, Key key) {
+    spec.assign(key, "true");
+    return ParseResult::SUCCESS;
+  }
+
+  ParseResult missingValue(const OptionToken& token) {
+    return fail("Missing value for option", token.word,
+                ParseResult::MISSING_VALUE);
+  }
+
+  ParseResult store(const OptionToken& token, Key key) {
+    if (!spec.assign(key, token.value)) {
+      return fail("Invalid value for option", token.value,
+                  ParseResult::INVALID_VALUE);
+    }
+    return ParseResult::SUCCESS;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Parse entry point shared by the parsers generated by
+ * argsparser_generate
+ *
+ * The generated struct matches names with switch statements and converts
+ * values straight into its fields with convertValue(); the token loop is the
+ * one Parser::parse() uses, so the syntax is the same, and no virtual calls,
+ * maps or heap allocations are involved.
+ * @tparam Spec The generated struct, providing kOptionCount,
+ * kPositionalCount, findLong(), findShort(), isFlag(), isRequired(), nameOf(),
+ * assign(), isSet(), clearSet() and error
+ * @param spec The struct to fill; string fields refer to argv
+ * @param argc The number of command-line arguments
+ * @param argv The array of command-line argument strings
+ * @return ParseResult The result, with details in spec.error on failure
+ */
+template <typename Spec>
+ParseResult parseGenerated(Spec& spec, int argc, char** argv) {
+  spec.clearSet();
+  spec.error = GeneratedError();
+  if (detail::helpRequested(argc, argv,
+                            [](std::string_view) { return false; })) {
+    return ParseResult::HELP_REQUESTED;
+  }
+
+  detail::GeneratedHooks<Spec> hooks{spec};
+  const ParseResult result = detail::tokenizeArguments(argc, argv, hooks);
+  if (result != ParseResult::SUCCESS) {
+    return result;
+  }
+  if (hooks.positionalCount > Spec::kPositionalCount) {
+    return hooks.fail("Too many positional arguments", std::string_view(),
+                      ParseResult::INVALID_VALUE);
+  }
+  for (int index = 0; index < Spec::kOptionCount + Spec::kPositionalCount;
+       ++index) {
+    if (Spec::isRequired(index) && !spec.isSet(index)) {
+      return hooks.fail(index < Spec::kOptionCount
+                            ? "Missing required option"
+                            : "Missing required positional argument",
+                        Spec::nameOf(index), ParseResult::MISSING_VALUE);
+    }
+  }
+  return ParseResult::SUCCESS;
+}
 
-    longNameMap_[name] = ptr;
-    shortNameMap_[shortName] = ptr;
-    arguments_.push_back(std::move(arg));
+/**
+ * @brief Why the last ReloadableConfig reload was rejected
+ */
+struct ReloadError {
+  ParseResult result{ParseResult::SUCCESS};  ///< SUCCESS after a publish
+  ConfigError location;  ///< Line and column of config file errors
+  std::string message;   ///< The rejected parser's getLastError()
+  std::uint64_t generation{0};  ///< Generation of the published snapshot
+};
 
-    return ptr;
-  }
+/**
+ * @brief Options re-read from a config file at runtime and published as
+ * immutable snapshots
+ *
+ * Every reload registers the options on a fresh Parser, reads the file with
+ * parseConfigFile() and then applies the environment and the command line
+ * given at construction, so precedence is the same as at startup. Only a
+ * reload that succeeds completely is published, by swapping one atomic
+ * pointer; a rejected reload leaves the published snapshot untouched and is
+ * described by getLastReloadError().
+ *
+ * Readers never block: read() increments one of two reader counters, loads
+ * the pointer and returns a guard that decrements the counter again. A
+ * replaced snapshot is retired and freed by a later reload() or reclaim()
+ * once both counters have drained since the swap (a grace period, as in
+ * RCU). Reloads are serialized by a mutex that readers never take.
+ */
+class ReloadableConfig {
+ public:
+  /// Registers the options on each new snapshot's parser
+  using RegisterFn = void (*)(Parser& parser);
 
-  /**
-   * @brief Add a new positional argument to the parser
-   *
-   * @tparam T The type of the argument (e.g., std::string, int)
-   * @param name The name of the positional argument
-   * @param description A description of the argument for help text
-   * @param required Whether this argument is required (default: true)
-   * @param defaultValue The default value for this argument (default: T{})
-   * @return Argument<T>* Pointer to the created argument
-   */
-  template <typename T>
-  Argument<T>*
-  addPositionalArgument(const std::string& name, const std::string& description,
-                        bool required = true, const T& defaultValue = T{}) {
-    auto arg = std::make_unique<Argument<T>>(name, "", description, required,
-                                             defaultValue);
-    Argument<T>* ptr = arg.get();
-    positionalArguments_.push_back(std::move(arg));
-    return ptr;
-  }
+  /// Returned by Snapshot::indexOf() when no argument matches
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
   /**
-   * @brief Parse command-line arguments
-   *
-   * @param argc The number of command-line arguments
-   * @param argv The array of command-line argument strings
-   * @return ParseResult The result of the parsing operation
-   * @note Supports both long options (--) and short options (-), including
-   * grouped short options (-abc) and options with values (--option=value or
-   * -ovalue).
-   */ // NOLINTNEXTLINE(readability-function-cognitive-complexity)
-  ParseResult parse(int argc, char** argv) {
-    // Clear the last error
-    lastError_.clear();
-
-    // Check for help flag first
-    for (int i = 1; i < argc; ++i) {
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-      const std::string arg{argv[i]};
-      if (arg == "--help" || arg == "-h") {
-        return ParseResult::HELP_REQUESTED;
-      }
+   * @brief One immutable, fully parsed version of the configuration
+   */
+  class Snapshot {
+   private:
+    friend class ReloadableConfig;
+    Parser parser_;
+    std::uint64_t generation_;
+    PackedValues packed_;
+
+   public:
+    /**
+     * @brief Construct an empty snapshot (used by ReloadableConfig)
+     * @param programName The program name used in help text
+     * @param generation The number of successful reloads before this one
+     */
+    Snapshot(const std::string& programName, std::uint64_t generation)
+        : parser_(programName), generation_(generation) {}
+
+    /**
+     * @brief Get the parser holding this snapshot's values
+     * @return const Parser& The parser
+     */
+    [[nodiscard]] const Parser& parser() const { return parser_; }
+
+    /**
+     * @brief Get the number of successful reloads this snapshot reflects
+     * @return std::uint64_t 0 for the defaults published at construction
+     */
+    [[nodiscard]] std::uint64_t getGeneration() const { return generation_; }
+
+    /**
+     * @brief Get the value of an argument
+     * @tparam T The type of the argument value
+     * @param name The name of the argument
+     * @return const T& The value, as Parser::getValue() returns it
+     */
+    template <typename T>
+    [[nodiscard]] const T& getValue(std::string_view name) const {
+      return parser_.getValue<T>(name);
     }
 
-    // Collect non-option arguments for positional arguments
-    std::vector<std::string> positionalValues;
+    /**
+     * @brief Check if an argument was given by the file, environment or argv
+     * @param name The name of the argument
+     * @return true if the argument has a value other than its default
+     */
+    [[nodiscard]] bool isSet(std::string_view name) const {
+      return parser_.isSet(name);
+    }
 
-    // Parse arguments
-    for (int i = 1; i < argc; ++i) {
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-      const std::string arg{argv[i]};
+    /**
+     * @brief Get the values packed when the snapshot was published
+     * @return const PackedValues& The values, as Parser::packValues()
+     */
+    [[nodiscard]] const PackedValues& packedValues() const { return packed_; }
+
+    /**
+     * @brief Find the packed index of an argument
+     * @param name The name of the argument
+     * @return std::size_t The index, the same in every snapshot, or npos
+     */
+    [[nodiscard]] std::size_t indexOf(std::string_view name) const {
+      const auto& names = packed_.names;
+      const auto it = std::find(names.begin(), names.end(), name);
+      return it == names.end() ? npos
+                               : static_cast<std::size_t>(it - names.begin());
+    }
+  };
 
-      if (arg.empty() || arg[0] != '-') {
-        // Positional argument
-        positionalValues.push_back(arg);
-        continue;
-      }
+  /**
+   * @brief An argument whose value or set state changed in a reload
+   */
+  struct ChangeEvent {
+    std::string_view name;    ///< The argument's long name
+    std::size_t index;        ///< Its packed index
+    const Snapshot* before;   ///< The snapshot being replaced
+    const Snapshot* after;    ///< The snapshot just published
+  };
 
-      // Handle --option=value syntax
-      std::string name;
-      std::string value;
-      bool hasValue = false;
-      const bool isLong = (arg.length() > 1 && arg[1] == '-');
-
-      if (isLong) {
-        // Long option
-        const size_t equalPos = arg.find('=');
-        if (equalPos != std::string::npos) {
-          // --option=value format
-          name = arg.substr(2, equalPos - 2);
-          value = arg.substr(equalPos + 1);
-          hasValue = true;
-        } else {
-          // --option format
-          name = arg.substr(2);
-        }
-      } else {
-        // Short option
-        // Check if this is a grouped short option (e.g., -abc) or a short
-        // option with a value (e.g., -c123)
-        if (arg.length() > 2) {
-          // Extract the first character as the short option name
-          const std::string firstChar = arg.substr(1, 1);
-          auto it = shortNameMap_.find(firstChar);
-
-          // Check if the first character corresponds to a non-boolean argument
-          if (it != shortNameMap_.end() &&
-              dynamic_cast<Argument<bool>*>(it->second) == nullptr) {
-            // This is a short option with a value (e.g., -c123)
-            name = firstChar;
-            value = arg.substr(2);
-            hasValue = true;
-          } else {
-            // This might be a grouped short option
-            bool isGrouped = true;
-            for (size_t j = 1; j < arg.length(); ++j) {
-              const std::string shortName(1, arg[j]);
-              auto it = shortNameMap_.find(shortName);
-              if (it == shortNameMap_.end() ||
-                  dynamic_cast<Argument<bool>*>(it->second) == nullptr) {
-                // If any character doesn't correspond to a boolean flag,
-                // treat the whole thing as a single short option
-                isGrouped = false;
-                break;
-              }
-            }
+  /// Called on the reloading thread, with the reload lock held
+  using ChangeHandler = void (*)(const ChangeEvent& event, void* context);
 
-            if (isGrouped) {
-              // Process each character as a separate boolean flag
-              for (size_t j = 1; j < arg.length(); ++j) {
-                const std::string shortName(1, arg[j]);
-                auto it = shortNameMap_.find(shortName);
-                ArgumentBase* argument = it->second;
-
-                if (!argument->parse("true")) {
-                  lastError_ =
-                      std::string("Invalid value for flag: -") + shortName;
-                  return ParseResult::INVALID_VALUE;
-                }
-              }
-              continue;  // Move to the next argument
-            } else {
-              // Single short option
-              name = arg.substr(1);
-            }
-          }
-        } else {
-          // Single short option
-          name = arg.substr(1);
-        }
+  /**
+   * @brief Keeps a snapshot alive while a reader uses it
+   *
+   * Hold a guard only for the duration of one read-side section: a retired
+   * snapshot cannot be freed while any guard taken before its retirement is
+   * alive.
+   */
+  class ReadGuard {
+   private:
+    friend class ReloadableConfig;
+    std::atomic<std::size_t>* readers_;
+    const Snapshot* snapshot_;
+
+    ReadGuard(std::atomic<std::size_t>* readers, const Snapshot* snapshot)
+        : readers_(readers), snapshot_(snapshot) {}
+
+   public:
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+    ReadGuard& operator=(ReadGuard&&) = delete;
+
+    ReadGuard(ReadGuard&& other) noexcept
+        : readers_(std::exchange(other.readers_, nullptr)),
+          snapshot_(other.snapshot_) {}
+
+    /**
+     * @brief Leave the read-side section
+     */
+    ~ReadGuard() {
+      if (readers_ != nullptr) {
+        // Orders this reader's accesses before the reclaimer's check
+        readers_->fetch_sub(1, std::memory_order_release);
       }
+    }
 
-      // Find the argument
-      ArgumentBase* argument = nullptr;
-      if (isLong) {
-        auto it = longNameMap_.find(name);
-        if (it != longNameMap_.end()) {
-          argument = it->second;
-        }
-      } else {
-        auto it = shortNameMap_.find(name);
-        if (it != shortNameMap_.end()) {
-          argument = it->second;
-        }
-      }
+    [[nodiscard]] const Snapshot& operator*() const { return *snapshot_; }
+    [[nodiscard]] const Snapshot* operator->() const { return snapshot_; }
+  };
 
-      if (argument == nullptr) {
-        lastError_ =
-            std::string("Unknown option: ") + (isLong ? "--" : "-") + name;
-        return ParseResult::UNKNOWN_OPTION;
-      }
+ private:
+  /// Reader counter on its own cache line, so the two do not share one
+  struct alignas(64) ReaderCount {
+    std::atomic<std::size_t> count{0};
+  };
 
-      // Handle boolean flags (no value expected)
-      if (dynamic_cast<Argument<bool>*>(argument) != nullptr) {
-        if (!argument->parse("true")) {
-          lastError_ = std::string("Invalid value for flag: ") +
-                       (isLong ? "--" : "-") + name;
-          return ParseResult::INVALID_VALUE;
-        }
-        continue;
-      }
+  std::string path_;
+  std::string programName_;
+  std::string watchedName_;
+  RegisterFn registerOptions_;
+  std::vector<char*> argv_;  ///< The replayed words, pointing into argv
+  mutable std::array<ReaderCount, 2> readers_;
+  std::atomic<unsigned> phase_{0};
+  std::atomic<Snapshot*> current_{nullptr};  // Owned
+  std::mutex reloadMutex_;
+  /// Replaced snapshots and the grace period they were retired in
+  std::vector<std::pair<std::unique_ptr<Snapshot>, std::uint64_t>> retired_;
+  std::uint64_t gracePeriod_{0};
+  std::uint64_t generation_{0};
+  ReloadError lastError_;
+  int watchFd_{-1};
+
+  struct Observer {
+    std::size_t index;
+    ChangeHandler handler;
+    void* context;
+  };
+  std::vector<Observer> observers_;  // Sorted by index
 
-      // For non-boolean arguments, get the value
-      if (!hasValue) {
-        // Expect a value from the next argument
-        if (i + 1 >= argc) {
-          lastError_ = std::string("Missing value for option: ") +
-                       (isLong ? "--" : "-") + name;
-          return ParseResult::MISSING_VALUE;
-        }
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        value = argv[++i];
+  /**
+   * @brief Call the observers of the arguments that differ between snapshots
+   * @param before The replaced snapshot
+   * @param after The published snapshot
+   */
+  void notifyObservers(const Snapshot& before, const Snapshot& after) {
+    if (observers_.empty()) {
+      return;
+    }
+    // Both lists are sorted by index
+    auto observer = observers_.begin();
+    for (const std::size_t index : diff(before, after)) {
+      while (observer != observers_.end() && observer->index < index) {
+        ++observer;
       }
-
-      if (!argument->parse(value)) {
-        std::string error = "Invalid value for option: ";
-        error += (isLong ? "--" : "-");
-        error += name;
-        error += " = ";
-        error += value;
-        lastError_ = std::move(error);
-        return ParseResult::INVALID_VALUE;
+      for (; observer != observers_.end() && observer->index == index;
+           ++observer) {
+        const ChangeEvent event{after.packed_.names[index], index, &before,
+                                &after};
+        observer->handler(event, observer->context);
       }
     }
+  }
 
-    // Parse positional arguments
-    size_t positionalIndex = 0;
-    for (const auto& arg : positionalArguments_) {
-      if (positionalIndex >= positionalValues.size()) {
-        if (arg->isRequired()) {
-          lastError_ = std::string("Missing required positional argument: ") +
-                       arg->getName();
-          return ParseResult::MISSING_VALUE;
-        }
-        // Use default value
+  /**
+   * @brief Select the command-line words that every reload applies
+   *
+   * Help and completion requests are answered once, at startup; replayed,
+   * they would fail every reload with HELP_REQUESTED or COMPLETION_REQUESTED.
+   * @param argc The number of command-line arguments
+   * @param argv The command-line arguments
+   * @return std::vector<char*> argv without --help and -h (up to "--"), and
+   * only argv[0] for a completion query
+   */
+  static std::vector<char*> replayedWords(int argc, char** argv) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (argc > 1 && std::strcmp(argv[1], detail::kCompleteFlag) == 0) {
+      argc = 1;
+    }
+    std::vector<char*> words;
+    bool optionsEnded = false;
+    for (int i = 0; i < argc; ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const std::string_view word{argv[i]};
+      if (i > 0 && !optionsEnded && (word == "--help" || word == "-h")) {
         continue;
       }
-
-      if (!arg->parse(positionalValues[positionalIndex])) {
-        lastError_ = std::string("Invalid value for positional argument: ") +
-                     arg->getName() + " = " + positionalValues[positionalIndex];
-        return ParseResult::INVALID_VALUE;
-      }
-      ++positionalIndex;
+      optionsEnded = optionsEnded || word == "--";
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      words.push_back(argv[i]);
     }
+    return words;
+  }
 
-    // Check if there are too many positional arguments
-    if (positionalIndex < positionalValues.size()) {
-      lastError_ = "Too many positional arguments";
-      return ParseResult::INVALID_VALUE;
+  /**
+   * @brief Publish a snapshot and retire the one it replaces
+   * @param next The new snapshot
+   */
+  void publish(std::unique_ptr<Snapshot> next) {
+    std::unique_ptr<Snapshot> previous(current_.exchange(next.release()));
+    if (previous) {
+      retired_.emplace_back(std::move(previous), gracePeriod_);
     }
+  }
 
-    // Check required option arguments
-    for (const auto& arg : arguments_) {
-      if (arg->isRequired() && !arg->isSet()) {
-        lastError_ =
-            std::string("Missing required option: --") + arg->getName();
-        return ParseResult::MISSING_VALUE;
+  /**
+   * @brief Free the retired snapshots no reader can still hold
+   *
+   * A grace period ends when the counter readers are not entering has
+   * drained; the phase then flips, so consecutive grace periods check
+   * alternate counters. A reader increments its counter before it loads the
+   * pointer, so after two grace periods every reader that could have loaded
+   * a retired snapshot has left. Never waits for readers.
+   * @return std::size_t The number of snapshots still retired
+   */
+  std::size_t reclaimRetired() {
+    for (int step = 0; step < 2 && !retired_.empty(); ++step) {
+      const unsigned phase = phase_.load();
+      if (readers_[phase ^ 1U].count.load() != 0) {
+        break;
       }
+      phase_.store(phase ^ 1U);
+      ++gracePeriod_;
     }
+    retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                  [this](const auto& entry) {
+                                    return entry.second + 2 <= gracePeriod_;
+                                  }),
+                   retired_.end());
+    return retired_.size();
+  }
 
-    return ParseResult::SUCCESS;
+ public:
+  /**
+   * @brief Construct a configuration and publish its defaults
+   *
+   * The file is not read until reload() is called.
+   * @param path The path of the key=value / INI config file
+   * @param registerOptions Adds the options to each snapshot's parser
+   * @param argc The number of command-line arguments applied on every reload
+   * (0 for none)
+   * @param argv The command-line arguments; must outlive the configuration.
+   * --help, -h and shell completion queries are not replayed.
+   */ // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+  ReloadableConfig(std::string path, RegisterFn registerOptions,
+                   int argc = 0, char** argv = nullptr)
+      : path_(std::move(path)),
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        programName_(argc > 0 ? argv[0] : path_),
+        registerOptions_(registerOptions),
+        argv_(replayedWords(argc, argv)) {
+    const std::size_t slash = path_.rfind('/');
+    watchedName_ =
+        slash == std::string::npos ? path_ : path_.substr(slash + 1);
+    auto initial = std::make_unique<Snapshot>(programName_, 0);
+    registerOptions_(initial->parser_);
+    initial->parser_.packValues(initial->packed_);
+    publish(std::move(initial));
   }
 
+  ReloadableConfig(const ReloadableConfig&) = delete;
+  ReloadableConfig& operator=(const ReloadableConfig&) = delete;
+  ReloadableConfig(ReloadableConfig&&) = delete;
+  ReloadableConfig& operator=(ReloadableConfig&&) = delete;
+
   /**
-   * @brief Print help information for all arguments
+   * @brief Free all snapshots and stop watching
+   * @note No ReadGuard may outlive the configuration.
+   */
+  ~ReloadableConfig() {
+    const std::unique_ptr<Snapshot> current(current_.load());  // Frees it
+#if ARGSPARSER_HAS_INOTIFY
+    if (watchFd_ >= 0) {
+      ::close(watchFd_);
+    }
+#endif
+  }
+
+  /**
+   * @brief Enter a read-side section on the published snapshot
    *
-   * @param os The output stream to print to (default: std::cout)
-   * @note The help output includes both option arguments and positional
-   * arguments, as well as a usage line showing how to use the program.
+   * Wait-free: one counter increment and one pointer load.
+   * @return ReadGuard The guard giving access to the snapshot
    */
-  void printHelp(std::ostream& os = std::cout) const {
-    os << "Usage: " << programName_;
+  [[nodiscard]] ReadGuard read() const {
+    // Any phase is safe; a stale one only delays reclamation
+    auto& readers = readers_[phase_.load(std::memory_order_relaxed)].count;
+    readers.fetch_add(1);  // Sequentially consistent with the load below
+    return ReadGuard(&readers, current_.load());
+  }
 
-    // Print options
-    const bool hasOptions = !arguments_.empty();
-    if (hasOptions) {
-      os << " [OPTIONS]";
+  /**
+   * @brief Re-read the config file and publish the result
+   *
+   * All or nothing: if any step fails, the published snapshot stays and
+   * getLastReloadError() describes the failure.
+   * @return ParseResult SUCCESS if a new snapshot was published, otherwise
+   * the result of parseConfigFile() or parse()
+   */
+  ParseResult reload() {
+    const std::lock_guard<std::mutex> lock(reloadMutex_);
+    auto next = std::make_unique<Snapshot>(programName_, generation_ + 1);
+    registerOptions_(next->parser_);
+    ParseResult result = next->parser_.parseConfigFile(path_);
+    if (result == ParseResult::SUCCESS) {
+      result = next->parser_.parse(static_cast<int>(argv_.size()),
+                                   argv_.data());
     }
-
-    // Print positional arguments
-    for (const auto& arg : positionalArguments_) {
-      os << " ";
-      if (!arg->isRequired()) {
-        os << "[";
-      }
-      os << "<" << arg->getName() << ">";
-      if (!arg->isRequired()) {
-        os << "]";
-      }
+    if (result != ParseResult::SUCCESS) {
+      lastError_ = ReloadError{result, next->parser_.getLastConfigError(),
+                               next->parser_.getLastError(), generation_};
+      return result;
     }
-    os << "\n";
+    ++generation_;
+    lastError_ = ReloadError{};
+    lastError_.generation = generation_;
+    next->parser_.packValues(next->packed_);
+    // The replaced snapshot stays alive until reclaimRetired()
+    const Snapshot* before = current_.load();
+    const Snapshot* after = next.get();
+    publish(std::move(next));
+    notifyObservers(*before, *after);
+    reclaimRetired();
+    return ParseResult::SUCCESS;
+  }
 
-    if (!description_.empty()) {
-      os << description_ << "\n\n";
+  /**
+   * @brief Call a handler whenever an argument changes in a reload
+   *
+   * An argument changes when its value or its set state differs between the
+   * replaced and the published snapshot; handlers of unchanged arguments are
+   * not called. Handlers must not call reload(), reclaim() or observe().
+   * @param name The name of the argument
+   * @param handler The function to call
+   * @param context Passed to the handler unchanged
+   * @return true on success, false if no argument has that name
+   */
+  bool observe(std::string_view name, ChangeHandler handler,
+               void* context = nullptr) {
+    const std::lock_guard<std::mutex> lock(reloadMutex_);
+    const std::size_t index = current_.load()->indexOf(name);
+    if (index == npos) {
+      return false;
     }
+    const auto position = std::upper_bound(
+        observers_.begin(), observers_.end(), index,
+        [](std::size_t key, const Observer& entry) {
+          return key < entry.index;
+        });
+    observers_.insert(position, Observer{index, handler, context});
+    return true;
+  }
 
-    // Print option arguments
-    if (hasOptions) {
-      os << "Options:\n";
-      for (const auto& arg : arguments_) {
-        arg->printHelp(os);
+  /**
+   * @brief List the arguments that differ between two snapshots
+   *
+   * Compares the packed values a word at a time: the set bitsets are XORed
+   * 64 arguments at once, value slots are compared as integers, and string
+   * text only where the hashes agree. No names are looked up.
+   * @param before The earlier snapshot
+   * @param after The later snapshot (of the same configuration)
+   * @return std::vector<std::size_t> The packed indexes of the changed
+   * arguments in ascending order (all of them if the schemas differ)
+   */
+  [[nodiscard]] static std::vector<std::size_t> diff(const Snapshot& before,
+                                                     const Snapshot& after) {
+    const PackedValues& lhs = before.packed_;
+    const PackedValues& rhs = after.packed_;
+    std::vector<std::size_t> changed;
+    const std::size_t count = rhs.slots.size();
+    if (lhs.slots.size() != count) {
+      changed.resize(count);
+      for (std::size_t i = 0; i < count; ++i) {
+        changed[i] = i;
       }
-      os << "\n";
+      return changed;
     }
-
-    // Print positional arguments
-    if (!positionalArguments_.empty()) {
-      os << "Positional arguments:\n";
-      for (const auto& arg : positionalArguments_) {
-        arg->printHelp(os);
+    const std::vector<std::uint64_t>& lhsSet = lhs.set.words();
+    const std::vector<std::uint64_t>& rhsSet = rhs.set.words();
+    for (std::size_t word = 0; word < rhsSet.size(); ++word) {
+      std::uint64_t mask = lhsSet[word] ^ rhsSet[word];
+      const std::size_t first = word * detail::BitVector::kWordBits;
+      const std::size_t last =
+          std::min(first + detail::BitVector::kWordBits, count);
+      for (std::size_t i = first; i < last; ++i) {
+        if (lhs.slots[i] != rhs.slots[i] || lhs.text[i] != rhs.text[i]) {
+          mask |= std::uint64_t{1} << (i - first);
+        }
+      }
+      while (mask != 0) {
+        changed.push_back(first + detail::lowestSetBit(mask));
+        mask &= mask - 1;
       }
-      os << "\n";
     }
+    return changed;
+  }
 
-    os << "  -h, --help\n    Show this help message\n";
+  /**
+   * @brief Free retired snapshots that readers have finished with
+   *
+   * Called by every reload(); call it directly to release memory sooner.
+   * @return std::size_t The number of snapshots still held by readers
+   */
+  std::size_t reclaim() {
+    const std::lock_guard<std::mutex> lock(reloadMutex_);
+    return reclaimRetired();
   }
 
   /**
-   * @brief Check if an argument has been set
+   * @brief Get why the last reload was rejected
+   * @return ReloadError A copy of the error (result is SUCCESS if the last
+   * reload was published)
+   */
+  [[nodiscard]] ReloadError getLastReloadError() {
+    const std::lock_guard<std::mutex> lock(reloadMutex_);
+    return lastError_;
+  }
+
+  /**
+   * @brief Get the path of the config file
+   * @return const std::string& The path given at construction
+   */
+  [[nodiscard]] const std::string& getPath() const { return path_; }
+
+  /**
+   * @brief Start watching the config file with inotify
    *
-   * @param name The name of the argument to check
-   * @return true if the argument was provided, false otherwise
-   * @note Works for both option arguments and positional arguments.
+   * The file's directory is watched rather than the file itself, so editors
+   * that save by renaming a new file over the old one are noticed too.
+   * @return true if the watch is active, false if it could not be set up
+   * or inotify is not available (Linux only)
    */
-  [[nodiscard]] bool isSet(const std::string& name) const {
-    // Check option arguments first
-    auto it = longNameMap_.find(name);
-    if (it != longNameMap_.end()) {
-      return it->second->isSet();
+  bool watch() {
+#if ARGSPARSER_HAS_INOTIFY
+    if (watchFd_ >= 0) {
+      return true;
     }
-
-    // Check positional arguments
-    for (const auto& arg : positionalArguments_) {
-      if (arg->getName() == name) {
-        return arg->isSet();
-      }
+    const std::size_t slash = path_.rfind('/');
+    const std::string directory = slash == std::string::npos ? "."
+                                  : slash == 0 ? "/"
+                                               : path_.substr(0, slash);
+    watchFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd_ < 0) {
+      return false;
     }
-
+    if (::inotify_add_watch(watchFd_, directory.c_str(),
+                            IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+      ::close(watchFd_);
+      watchFd_ = -1;
+      return false;
+    }
+    return true;
+#else
     return false;
+#endif
   }
 
   /**
-   * @brief Get the parsed value of an argument
+   * @brief Get the descriptor to wait on for changes
    *
-   * @tparam T The type of the argument value
-   * @param name The name of the argument
-   * @return const T& The parsed value of the argument
-   * @note If the argument doesn't exist or the type doesn't match, a default
-   * constructed value is returned.
+   * Becomes readable when the watched directory changes; add it to an
+   * existing poll()/epoll loop and call pollChanges(0) when it fires.
+   * @return int The inotify descriptor, or -1 if not watching
    */
-  template <typename T>
-  const T& getValue(const std::string& name) const {
-    // Check option arguments first
-    auto it = longNameMap_.find(name);
-    if (it != longNameMap_.end()) {
-      // This is safe because we know the type matches
-      auto* arg = dynamic_cast<Argument<T>*>(it->second);
-      if (arg) {
-        return arg->getValue();
-      }
-    }
+  [[nodiscard]] int getWatchDescriptor() const { return watchFd_; }
 
-    // Check positional arguments
-    for (const auto& arg : positionalArguments_) {
-      if (arg->getName() == name) {
-        // This is safe because we know the type matches
-        auto* posArg = dynamic_cast<Argument<T>*>(arg.get());
-        if (posArg) {
-          return posArg->getValue();
+  /**
+   * @brief Wait for the config file to change and reload it once if it did
+   *
+   * Drains all pending events, so a burst of writes causes one reload.
+   * @param timeoutMs How long to wait: 0 checks without waiting, -1 waits
+   * until something in the directory changes
+   * @return true if the file changed and a new snapshot was published;
+   * false if it did not change or the reload was rejected
+   */ // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  bool pollChanges(int timeoutMs = 0) {
+#if ARGSPARSER_HAS_INOTIFY
+    if (watchFd_ < 0) {
+      return false;
+    }
+    pollfd entry{watchFd_, POLLIN, 0};
+    if (::poll(&entry, 1, timeoutMs) <= 0) {
+      return false;
+    }
+    alignas(inotify_event) std::array<char, 4096> buffer{};
+    bool changed = false;
+    for (;;) {
+      const ssize_t got = ::read(watchFd_, buffer.data(), buffer.size());
+      if (got <= 0) {
+        break;  // EAGAIN once the queue is drained
+      }
+      std::size_t offset = 0;
+      while (offset + sizeof(inotify_event) <= static_cast<std::size_t>(got)) {
+        const auto event = detail::loadBytes<inotify_event>(buffer.data(),
+                                                            offset);
+        offset += sizeof(inotify_event);
+        // The name is NUL-padded to event.len bytes
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (event.len > 0 && watchedName_ == buffer.data() + offset) {
+          changed = true;
         }
+        offset += event.len;
       }
     }
-
-    // This should not happen in correct usage
-    static T defaultValue{};
-    return defaultValue;
+    return changed && reload() == ParseResult::SUCCESS;
+#else
+    static_cast<void>(timeoutMs);
+    return false;
+#endif
   }
 };
 
 }  // namespace argsparser
 
+#if defined(ARGSPARSER_DEFINE_ALLOCATION_HOOKS)
+#if !defined(ARGSPARSER_ALLOCATION_ACCOUNTING)
+#error "The allocation hooks require ARGSPARSER_ALLOCATION_ACCOUNTING"
+#endif
+
+// Replacement global allocation functions that feed the allocation counters.
+// Define ARGSPARSER_DEFINE_ALLOCATION_HOOKS in exactly one translation unit.
+// Allocation failure aborts, as the library is built without exceptions.
+// Over-aligned allocations keep the standard library's implementation.
+
+void* operator new(std::size_t size) {
+  argsparser::recordAllocation(size);
+  void* ptr = std::malloc(size == 0 ? 1 : size);  // NOLINT
+  if (ptr == nullptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+  argsparser::recordAllocation(size);
+  return std::malloc(size == 0 ? 1 : size);  // NOLINT
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+  return ::operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);  // NOLINT
+}
+
+void operator delete[](void* ptr) noexcept { ::operator delete(ptr); }
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+  ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept {
+  ::operator delete(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t& /*tag*/) noexcept {
+  ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t& /*tag*/) noexcept {
+  ::operator delete(ptr);
+}
+
+#endif  // ARGSPARSER_DEFINE_ALLOCATION_HOOKS
+
 #endif  // ARGSPARSER_HPP
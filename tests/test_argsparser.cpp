@@ -1,8 +1,16 @@
+#include <array>
 #include <cassert>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
 
+#define ARGSPARSER_DEFINE_ALLOCATION_HOOKS
 #include "argsparser.hpp"
 
 // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
@@ -88,9 +96,527 @@ void test_validator() {
   auto result = parser.parse(argc, const_cast<char**>(argv));
   assert(result == argsparser::ParseResult::INVALID_VALUE);
 
+  // A rejected string leaves the default, then the last accepted value
+  auto* mode = parser.addArgument<std::string>("mode", "m", "Run mode", false,
+                                               "fast");
+  mode->setValidator(
+      [](const std::string& value) { return value != "broken"; });
+  const char* rejectedArgv[] = {"test_app", "--mode", "broken"};
+  result = parser.parse(3, const_cast<char**>(rejectedArgv));
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(mode->getValue() == "fast");
+  assert(mode->parse("safe"));
+  assert(!mode->parse("broken"));
+  assert(mode->getValue() == "safe");
+
   std::cout << "test_validator passed\n";
 }
 
+void test_capturing_validator() {
+  argsparser::Parser parser("test_app", "A test application");
+  auto* count = parser.addArgument<int32_t>("count", "c",
+                                            "Number of iterations (bounded)");
+  const int32_t lower = 1;
+  const int32_t upper = 10;
+  int32_t calls = 0;
+  count->setValidator([lower, upper, &calls](int32_t value) {
+    ++calls;
+    return value >= lower && value <= upper;
+  });
+
+  const char* badArgv[] = {"test_app", "--count", "11"};
+  auto result = parser.parse(3, const_cast<char**>(badArgv));
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+
+  const char* goodArgv[] = {"test_app", "--count", "7"};
+  result = parser.parse(3, const_cast<char**>(goodArgv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(count->getValue() == 7);
+  assert(calls == 2);
+
+  // An empty std::function clears the validator
+  count->setValidator(argsparser::Argument<int32_t>::Validator{});
+  result = parser.parse(3, const_cast<char**>(badArgv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(count->getValue() == 11);
+
+  std::cout << "test_capturing_validator passed\n";
+}
+
+struct Point {
+  int32_t x{0};
+  int32_t y{0};
+};
+
+// A custom type implements the std::string based parseValue() hook
+class PointArgument : public argsparser::Argument<Point> {
+ public:
+  using argsparser::Argument<Point>::Argument;
+
+ private:
+  bool parseValue(const std::string& value) override {
+    const std::size_t comma = value.find(',');
+    if (comma == std::string::npos) {
+      return false;
+    }
+    value_.x = static_cast<int32_t>(std::stoi(value.substr(0, comma)));
+    value_.y = static_cast<int32_t>(std::stoi(value.substr(comma + 1)));
+    return true;
+  }
+};
+
+void test_custom_argument_type() {
+  PointArgument origin("origin", "o", "Origin as x,y");
+  origin.setValidator([](const Point& point) { return point.x >= 0; });
+
+  // parse() keeps its std::string signature; parseView() forwards to it
+  assert(origin.parse(std::string("3,4")));
+  assert(origin.getValue().x == 3 && origin.getValue().y == 4);
+  assert(origin.isSet());
+  assert(origin.parseView(std::string_view("5,6;", 3)));
+  assert(origin.getValue().x == 5 && origin.getValue().y == 6);
+  assert(!origin.parseView("7"));
+  assert(!origin.parse("-1,0"));
+
+  std::cout << "test_custom_argument_type passed\n";
+}
+
+void test_oversized_validator() {
+  argsparser::Parser parser("test_app", "A test application");
+  auto* count = parser.addArgument<int32_t>("count", "c", "Allowed count");
+  std::array<int64_t, 32> allowed{};
+  for (std::size_t i = 0; i < allowed.size(); ++i) {
+    allowed[i] = static_cast<int64_t>(i * i);
+  }
+  static_assert(sizeof(allowed) > argsparser::kInlineValidatorCapacity);
+  count->setValidator([allowed](int32_t value) {
+    for (const int64_t candidate : allowed) {
+      if (candidate == value) {
+        return true;
+      }
+    }
+    return false;
+  });
+  const argsparser::MemoryUsage usage = parser.memoryUsage();
+  assert(usage.validators >=
+         sizeof(argsparser::InlineValidator<int32_t>) + sizeof(allowed));
+
+  const char* badArgv[] = {"test_app", "--count", "10"};
+  auto result = parser.parse(3, const_cast<char**>(badArgv));
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+
+  const char* goodArgv[] = {"test_app", "--count", "49"};
+  result = parser.parse(3, const_cast<char**>(goodArgv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(count->getValue() == 49);
+
+  // Replacing it with a small validator releases the heap copy
+  count->setValidator([](int32_t value) { return value > 0; });
+  assert(parser.memoryUsage().validators ==
+         sizeof(argsparser::InlineValidator<int32_t>));
+  result = parser.parse(3, const_cast<char**>(badArgv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+
+  std::cout << "test_oversized_validator passed\n";
+}
+
+void test_constraints() {
+  static_assert(argsparser::inRange(1, 10)(5), "5 is within [1, 10]");
+  static_assert(!argsparser::inRange(1, 10)(11), "11 is outside [1, 10]");
+  static_assert(argsparser::oneOf(2, 4, 8)(4), "4 is a listed choice");
+  static_assert(!argsparser::inRange(0U, 5U)(-1), "-1 is below 0U");
+
+  argsparser::Parser parser("test_app", "A test application");
+  auto* count = parser.addArgument<int32_t>("count", "c",
+                                            "Number of iterations", false, 10);
+  auto* mode =
+      parser.addArgument<std::string>("mode", "m", "Mode", false, "fast");
+  auto* name = parser.addArgument<std::string>("name", "n", "Name");
+
+  assert(count->setConstraint(argsparser::inRange(1, 100)));
+  assert(mode->setConstraint(argsparser::oneOf("fast", "slow")));
+  // The empty default does not satisfy nonEmpty, which is reported
+  assert(!name->setConstraint(argsparser::nonEmpty));
+
+  const char* badCount[] = {"test_app", "--count", "101"};
+  assert(parser.parse(3, const_cast<char**>(badCount)) ==
+         argsparser::ParseResult::INVALID_VALUE);
+
+  const char* badMode[] = {"test_app", "--mode", "medium"};
+  assert(parser.parse(3, const_cast<char**>(badMode)) ==
+         argsparser::ParseResult::INVALID_VALUE);
+
+  const char* badName[] = {"test_app", "--name="};
+  assert(parser.parse(2, const_cast<char**>(badName)) ==
+         argsparser::ParseResult::INVALID_VALUE);
+
+  const char* good[] = {"test_app", "-c", "100", "-m", "slow", "-n", "x"};
+  assert(parser.parse(7, const_cast<char**>(good)) ==
+         argsparser::ParseResult::SUCCESS);
+  assert(count->getValue() == 100);
+  assert(mode->getValue() == "slow");
+
+  std::ostringstream oss;
+  parser.printHelp(oss);
+  const std::string helpOutput = oss.str();
+  assert(helpOutput.find("(range: 1 to 100)") != std::string::npos);
+  assert(helpOutput.find("(one of: fast, slow)") != std::string::npos);
+  assert(helpOutput.find("(non-empty)") != std::string::npos);
+
+  std::cout << "test_constraints passed\n";
+}
+
+void test_environment_variables() {
+  argsparser::Parser parser("test_app", "A test application");
+  auto* threads = parser.addArgument<int32_t>("threads", "t", "Worker threads",
+                                              false, 1);
+  auto* host =
+      parser.addArgument<std::string>("host", "H", "Server host", true);
+  auto* port = parser.addArgument<int32_t>("port", "p", "Server port");
+  assert(parser.bindEnvironmentVariable("threads", "APP_THREADS"));
+  assert(parser.bindEnvironmentVariable("host", "APP_HOST"));
+  assert(parser.bindEnvironmentVariable("port", "APP_PORT"));
+  assert(!parser.bindEnvironmentVariable("missing", "APP_MISSING"));
+
+  const char* envp[] = {"PATH=/usr/bin", "APP_THREADS=8", "APP_HOST=example",
+                        "APP_PORT=80", nullptr};
+  const char* argv[] = {"test_app", "--port", "8080"};
+
+  // Environment satisfies the required option; argv takes precedence
+  auto result = parser.parse(3, const_cast<char**>(argv),
+                             const_cast<char**>(envp));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(threads->getValue() == 8);
+  assert(host->getValue() == "example");
+  assert(port->getValue() == 8080);
+  assert(threads->getSource() == argsparser::ValueSource::ENVIRONMENT);
+  assert(port->getSource() == argsparser::ValueSource::COMMAND_LINE);
+
+  const char* badEnvp[] = {"APP_THREADS=many", nullptr};
+  argsparser::Parser badParser("test_app");
+  badParser.addArgument<int32_t>("threads", "t", "Worker threads");
+  assert(badParser.bindEnvironmentVariable("threads", "APP_THREADS"));
+  result = badParser.parse(1, const_cast<char**>(argv),
+                           const_cast<char**>(badEnvp));
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(badParser.getLastError() ==
+         "Invalid value for environment variable: APP_THREADS = many");
+
+  std::ostringstream oss;
+  parser.printHelp(oss);
+  assert(oss.str().find("(env: APP_THREADS)") != std::string::npos);
+
+  std::cout << "test_environment_variables passed\n";
+}
+
+void test_config_file() {
+  argsparser::Parser parser("test_app", "A test application");
+  auto* threads = parser.addArgument<int32_t>("threads", "t", "Worker threads",
+                                              false, 1);
+  auto* host =
+      parser.addArgument<std::string>("host", "H", "Server host", true);
+  auto* verbose =
+      parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  auto* cacheSize =
+      parser.addArgument<uint64_t>("cache.size", "", "Cache size in bytes");
+  auto* rate = parser.addArgument<double>("rate", "r", "Rate", false, 1.0);
+  assert(parser.bindEnvironmentVariable("rate", "APP_RATE"));
+
+  const char* path = "test_argsparser_config.ini";
+  std::FILE* file = std::fopen(path, "w");
+  assert(file != nullptr);
+  std::fputs(
+      "# comment\r\n"
+      "threads = 4\n"
+      "host = \"file host\"  ; trailing comment\n"
+      "verbose = true\n"
+      "rate = 2.5\n"
+      "\n"
+      "[cache]\n"
+      "size=1048576\n",
+      file);
+  std::fclose(file);
+
+  auto result = parser.parseConfigFile(path);
+  std::remove(path);
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(threads->getValue() == 4);
+  assert(host->getValue() == "file host");
+  assert(verbose->getValue());
+  assert(cacheSize->getValue() == 1048576);
+  assert(threads->getSource() == argsparser::ValueSource::CONFIG_FILE);
+
+  // defaults < file < env < argv
+  const char* envp[] = {"APP_RATE=3.5", nullptr};
+  const char* argv[] = {"test_app", "--threads", "16"};
+  result =
+      parser.parse(3, const_cast<char**>(argv), const_cast<char**>(envp));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(threads->getValue() == 16);
+  assert(rate->getValue() == 3.5);
+  assert(host->getValue() == "file host");
+
+  // A file read after parse() does not override argv
+  result = parser.parseConfig("threads = 2\n");
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(threads->getValue() == 16);
+
+  std::cout << "test_config_file passed\n";
+}
+
+void test_config_file_errors() {
+  argsparser::Parser parser("test_app", "A test application");
+  parser.addArgument<int32_t>("threads", "t", "Worker threads");
+
+  auto result = parser.parseConfig("threads = 1\n  threads 2\n", "app.ini");
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(parser.getLastConfigError().line == 2);
+  assert(parser.getLastConfigError().column == 12);
+  assert(parser.getLastError() == "app.ini:2:12: expected '=' after key");
+
+  result = parser.parseConfig("threads = lots\n", "app.ini");
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(parser.getLastError() ==
+         "app.ini:1:11: invalid value for option 'threads'");
+
+  result = parser.parseConfig("\n[net\n", "app.ini");
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(parser.getLastError() == "app.ini:2:1: unterminated section header");
+
+  result = parser.parseConfig("[net]\nport = 80\n", "app.ini");
+  assert(result == argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(parser.getLastError() == "app.ini:2:1: unknown option 'net.port'");
+
+  result = parser.parseConfigFile("does/not/exist.ini");
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(parser.getLastError() ==
+         "does/not/exist.ini: cannot open config file");
+
+  std::cout << "test_config_file_errors passed\n";
+}
+
+int registeredSubcommands = 0;
+
+void registerCommit(argsparser::Parser& parser) {
+  ++registeredSubcommands;
+  parser.addArgument<std::string>("message", "m", "Commit message", true);
+  parser.addArgument<bool>("all", "a", "Stage all changes");
+}
+
+void registerPush(argsparser::Parser& parser) {
+  ++registeredSubcommands;
+  parser.addArgument<bool>("force", "f", "Force the push");
+}
+
+void registerStatus(argsparser::Parser& parser) {
+  ++registeredSubcommands;
+  parser.addArgument<bool>("short", "s", "Short format");
+}
+
+// Deliberately unsorted to exercise the lazily built index
+const argsparser::Subcommand kSubcommands[] = {
+    {"status", "Show the working tree status", registerStatus},
+    {"commit", "Record changes", registerCommit},
+    {"push", "Update remote refs", registerPush},
+};
+
+void test_subcommands() {
+  argsparser::Parser parser("vcs", "A version control tool");
+  auto* verbose =
+      parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  parser.setSubcommands(kSubcommands);
+  registeredSubcommands = 0;
+
+  const char* argv[] = {"vcs", "-v", "commit", "-a", "--message", "hello"};
+  auto result = parser.parse(6, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(verbose->getValue());
+  assert(registeredSubcommands == 1);
+  assert(parser.getSubcommand() != nullptr);
+  assert(std::string(parser.getSubcommand()->name) == "commit");
+
+  argsparser::Parser* commit = parser.getSubcommandParser();
+  assert(commit != nullptr);
+  assert(commit->getValue<std::string>("message") == "hello");
+  assert(commit->isSet("all"));
+
+  // Subcommand errors are reported through the parent
+  const char* missing[] = {"vcs", "commit"};
+  result = parser.parse(2, const_cast<char**>(missing));
+  assert(result == argsparser::ParseResult::MISSING_VALUE);
+  assert(parser.getLastError() == "Missing required option: --message");
+
+  // Help after the subcommand belongs to the subcommand
+  const char* help[] = {"vcs", "push", "--help"};
+  result = parser.parse(3, const_cast<char**>(help));
+  assert(result == argsparser::ParseResult::HELP_REQUESTED);
+  assert(parser.getSubcommandParser() != nullptr);
+  std::ostringstream pushHelp;
+  parser.getSubcommandParser()->printHelp(pushHelp);
+  assert(pushHelp.str().find("Usage: vcs push") != std::string::npos);
+
+  const char* unknown[] = {"vcs", "pull"};
+  result = parser.parse(2, const_cast<char**>(unknown));
+  assert(result == argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(parser.getLastError() == "Unknown subcommand: pull");
+  assert(parser.getSubcommand() == nullptr);
+
+  std::ostringstream oss;
+  parser.printHelp(oss);
+  assert(oss.str().find("<command>") != std::string::npos);
+  assert(oss.str().find("Record changes") != std::string::npos);
+
+  std::cout << "test_subcommands passed\n";
+}
+
+std::string complete(argsparser::Parser& parser,
+                     std::initializer_list<const char*> words) {
+  std::vector<const char*> argv{"vcs", "--__complete"};
+  argv.insert(argv.end(), words.begin(), words.end());
+  auto result = parser.parse(static_cast<int>(argv.size()),
+                             const_cast<char**>(argv.data()));
+  assert(result == argsparser::ParseResult::COMPLETION_REQUESTED);
+  std::ostringstream oss;
+  parser.printCompletions(oss);
+  return oss.str();
+}
+
+void test_shell_completion() {
+  argsparser::Parser parser("vcs", "A version control tool");
+  parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  parser.addArgument<bool>("version", "V", "Print the version");
+  auto* color = parser.addArgument<std::string>("color", "c", "Color mode",
+                                                false, "auto");
+  assert(color->setConstraint(argsparser::oneOf("always", "auto", "never")));
+  parser.setSubcommands(kSubcommands);
+
+  // Completion queries are opt-in
+  const char* query[] = {"vcs", "--__complete", "--ver"};
+  auto result = parser.parse(3, const_cast<char**>(query));
+  assert(result == argsparser::ParseResult::UNKNOWN_OPTION);
+  parser.enableCompletion();
+
+  assert(complete(parser, {"--ver"}) == "--verbose\n--version\n");
+  assert(complete(parser, {"--h"}) == "--help\n");
+  assert(complete(parser, {"--color", "a"}) == "always\nauto\n");
+  assert(complete(parser, {"--color", "=", "n"}) == "never\n");
+  assert(complete(parser, {"--color=al"}) == "--color=always\n");
+  assert(complete(parser, {"--color=a"}) ==
+         "--color=always\n--color=auto\n");
+  assert(complete(parser, {"p"}) == "push\n");
+  assert(complete(parser, {"-v", "commit", "--m"}) == "--message\n");
+  assert(complete(parser, {"--zzz"}).empty());
+
+  std::ostringstream bash;
+  parser.printBashCompletion(bash);
+  assert(bash.str().find("--__complete") != std::string::npos);
+  assert(bash.str().find("complete -o default -F _vcs_complete vcs") !=
+         std::string::npos);
+
+  std::ostringstream zsh;
+  parser.printZshCompletion(zsh);
+  assert(zsh.str().find("#compdef vcs") != std::string::npos);
+
+  std::cout << "test_shell_completion passed\n";
+}
+
+void test_abbreviations() {
+  argsparser::Parser parser("test_app", "A test application");
+  auto* verbose =
+      parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  parser.addArgument<bool>("version", "V", "Print the version");
+  auto* verb = parser.addArgument<bool>("verb", "", "Exact short name");
+  auto* count = parser.addArgument<int32_t>("count", "c", "Iterations");
+
+  // Disabled by default
+  const char* abbreviated[] = {"test_app", "--verbo", "--cou=3"};
+  assert(parser.parse(3, const_cast<char**>(abbreviated)) ==
+         argsparser::ParseResult::UNKNOWN_OPTION);
+
+  parser.setAllowAbbreviations(true);
+  assert(parser.parse(3, const_cast<char**>(abbreviated)) ==
+         argsparser::ParseResult::SUCCESS);
+  assert(verbose->getValue());
+  assert(count->getValue() == 3);
+
+  // Exact matches win over longer names sharing the prefix
+  const char* exact[] = {"test_app", "--verb"};
+  assert(parser.parse(2, const_cast<char**>(exact)) ==
+         argsparser::ParseResult::SUCCESS);
+  assert(verb->getValue());
+
+  const char* ambiguous[] = {"test_app", "--vers"};
+  assert(parser.parse(2, const_cast<char**>(ambiguous)) ==
+         argsparser::ParseResult::SUCCESS);
+  const char* ambiguous2[] = {"test_app", "--ver"};
+  assert(parser.parse(2, const_cast<char**>(ambiguous2)) ==
+         argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(parser.getLastError() ==
+         "Ambiguous option: --ver (could be --verb, --verbose, ...)");
+
+  std::cout << "test_abbreviations passed\n";
+}
+
+void test_unknown_option_suggestions() {
+  argsparser::Parser parser("test_app", "A test application");
+  parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  parser.addArgument<std::string>("output", "o", "Output file path");
+  parser.addArgument<int32_t>("count", "c", "Number of iterations");
+  for (int i = 0; i < 200; ++i) {
+    parser.addArgument<bool>("feature-" + std::to_string(i), "",
+                             "Generated feature flag");
+  }
+
+  const char* transposed[] = {"test_app", "--verbsoe"};
+  assert(parser.parse(2, const_cast<char**>(transposed)) ==
+         argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(parser.getLastError() ==
+         "Unknown option: --verbsoe (did you mean --verbose?)");
+
+  const char* typo[] = {"test_app", "--ouptut=x"};
+  assert(parser.parse(2, const_cast<char**>(typo)) ==
+         argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(parser.getLastError() ==
+         "Unknown option: --ouptut (did you mean --output?)");
+
+  const char* generated[] = {"test_app", "--feature-1O7"};
+  assert(parser.parse(2, const_cast<char**>(generated)) ==
+         argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(parser.getLastError() ==
+         "Unknown option: --feature-1O7 (did you mean --feature-107?)");
+
+  const char* farOff[] = {"test_app", "--xyz"};
+  assert(parser.parse(2, const_cast<char**>(farOff)) ==
+         argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(parser.getLastError() == "Unknown option: --xyz");
+
+  // "act" roots the tree and "cat" hangs off it at one transposition, but
+  // "chat" is three edits from "act": the tree must not prune "cat"
+  argsparser::Parser anagrams("test_app");
+  anagrams.addArgument<bool>("act", "", "Act");
+  anagrams.addArgument<bool>("cat", "", "Cat");
+  const char* nearMiss[] = {"test_app", "--chat"};
+  assert(anagrams.parse(2, const_cast<char**>(nearMiss)) ==
+         argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(anagrams.getLastError() ==
+         "Unknown option: --chat (did you mean --cat?)");
+  const char* swapped[] = {"test_app", "--atc"};
+  assert(anagrams.parse(2, const_cast<char**>(swapped)) ==
+         argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(anagrams.getLastError() ==
+         "Unknown option: --atc (did you mean --act?)");
+
+  argsparser::Parser vcs("vcs");
+  vcs.setSubcommands(kSubcommands);
+  const char* command[] = {"vcs", "comit"};
+  assert(vcs.parse(2, const_cast<char**>(command)) ==
+         argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(vcs.getLastError() ==
+         "Unknown subcommand: comit (did you mean commit?)");
+
+  std::cout << "test_unknown_option_suggestions passed\n";
+}
+
 void test_print_help() {
   argsparser::Parser parser("test_app", "A test application");
   parser.addArgument<bool>("verbose", "v", "Enable verbose output");
@@ -216,6 +742,50 @@ void test_too_many_positional_arguments() {
   std::cout << "test_too_many_positional_arguments passed\n";
 }
 
+void test_option_terminator() {
+  argsparser::Parser parser("test_app", "A test application");
+  auto* verbose =
+      parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  auto* inputFile =
+      parser.addPositionalArgument<std::string>("input", "Input file path");
+  auto* outputFile = parser.addPositionalArgument<std::string>(
+      "output", "Output file path", false);
+  std::string blob;
+  assert(parser.freezeSchema(blob));
+
+  // Words after "--" are positional, even if they look like options
+  const char* argv[] = {"test_app", "-v", "--", "--help", "-v"};
+  const int argc = sizeof(argv) / sizeof(argv[0]);
+  auto result = parser.parse(argc, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(verbose->getValue());
+  assert(inputFile->getValue() == "--help");
+  assert(outputFile->getValue() == "-v");
+
+  // Only the first "--" is the terminator
+  const char* twiceArgv[] = {"test_app", "--", "--", "x"};
+  result = parser.parse(4, const_cast<char**>(twiceArgv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(inputFile->getValue() == "--");
+  assert(outputFile->getValue() == "x");
+
+  const char* extraArgv[] = {"test_app", "a", "--", "b", "-c"};
+  result = parser.parse(5, const_cast<char**>(extraArgv));
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(parser.getLastError() == "Too many positional arguments");
+
+  // Frozen schemas follow the same rule
+  argsparser::FrozenSchema schema;
+  assert(schema.attach(blob));
+  argsparser::SchemaValues values;
+  result = schema.parse(argc, const_cast<char**>(argv), values);
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(schema.getValue<std::string>(values, "input") == "--help");
+  assert(schema.getValue<std::string>(values, "output") == "-v");
+
+  std::cout << "test_option_terminator passed\n";
+}
+
 void test_grouped_short_options() {
   argsparser::Parser parser("test_app", "A test application");
   auto* verbose =
@@ -267,6 +837,838 @@ void test_grouped_short_options_with_non_bool() {
 
   std::cout << "test_grouped_short_options_with_non_bool passed\n";
 }
+/**
+ * @brief Stream buffer that discards everything written to it
+ */
+class NullBuffer : public std::streambuf {
+ protected:
+  int overflow(int ch) override { return ch; }
+};
+
+void test_allocation_budgets() {
+  using argsparser::AllocationPhase;
+  using argsparser::getAllocationCounters;
+
+  argsparser::resetAllocationCounters();
+  argsparser::Parser parser("test_app", "A test application");
+  parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  parser.addArgument<bool>("force", "f", "Overwrite existing files");
+  parser.addArgument<int32_t>("count", "c", "Number of iterations", false, 10);
+  parser.addArgument<double>("ratio", "r", "Sampling ratio", false, 0.5);
+  parser.addArgument<std::string>("name", "n", "Short name");
+  parser.addPositionalArgument<std::string>("input", "Input file", false);
+  // Objects, pooled name copies, map nodes and index growth for this schema;
+  // a change here means registration got cheaper or more expensive
+  assert(getAllocationCounters(AllocationPhase::REGISTRATION).allocations ==
+         43);
+  assert(getAllocationCounters(AllocationPhase::PARSE).allocations == 0);
+
+  // Flags, numbers and short strings parse without touching the heap
+  const char* argv[] = {"test_app", "-vf",         "--count", "42",
+                        "-r",       "0.25",        "--name=short",
+                        "in.txt"};
+  const int argc = sizeof(argv) / sizeof(argv[0]);
+  argsparser::resetAllocationCounters();
+  auto result = parser.parse(argc, const_cast<char**>(argv), nullptr);
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(getAllocationCounters(AllocationPhase::PARSE).allocations == 0);
+  assert(parser.getValue<int32_t>("count") == 42);
+  assert(parser.getValue<std::string>("input") == "in.txt");
+
+  // Help for this schema is streamed without building temporaries
+  NullBuffer buffer;
+  std::ostream sink(&buffer);
+  argsparser::resetAllocationCounters();
+  parser.printHelp(sink);
+  assert(getAllocationCounters(AllocationPhase::HELP).allocations == 0);
+  assert(getAllocationCounters(AllocationPhase::PARSE).allocations == 0);
+
+  // A string value too long for the small-string buffer costs one allocation
+  const char* longArgv[] = {
+      "test_app", "--name", "a-value-well-beyond-the-small-string-buffer"};
+  const int longArgc = sizeof(longArgv) / sizeof(longArgv[0]);
+  argsparser::resetAllocationCounters();
+  result = parser.parse(longArgc, const_cast<char**>(longArgv), nullptr);
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(getAllocationCounters(AllocationPhase::PARSE).allocations == 1);
+
+  std::cout << "test_allocation_budgets passed\n";
+}
+
+/**
+ * @brief Trace events recorded by recordTraceEvent()
+ */
+struct RecordedTrace {
+  std::vector<argsparser::TraceEvent> events;
+  std::vector<std::string> names;  // Owned copies of the event names
+};
+
+void recordTraceEvent(const argsparser::TraceEvent& event, void* context) {
+  auto* trace = static_cast<RecordedTrace*>(context);
+  trace->events.push_back(event);
+  trace->names.emplace_back(event.name);
+}
+
+void test_trace_hooks() {
+  using argsparser::TracePhase;
+
+  argsparser::Parser parser("test_app", "A test application");
+  auto* count = parser.addArgument<int32_t>("count", "c", "Iterations");
+  count->setValidator([](int32_t value) { return value > 0; });
+
+  RecordedTrace trace;
+  argsparser::setTraceHandler(recordTraceEvent, &trace);
+  const char* argv[] = {"test_app", "--count", "5"};
+  const int argc = sizeof(argv) / sizeof(argv[0]);
+  auto result = parser.parse(argc, const_cast<char**>(argv), nullptr);
+  argsparser::setTraceHandler(nullptr);
+  assert(result == argsparser::ParseResult::SUCCESS);
+
+  struct Expected {
+    TracePhase phase;
+    bool begin;
+    int argvIndex;
+    const char* name;
+  };
+  const Expected expected[] = {
+      {TracePhase::TOKENIZE, true, 1, "--count"},
+      {TracePhase::TOKENIZE, false, 1, "--count"},
+      {TracePhase::LOOKUP, true, 1, "count"},
+      {TracePhase::LOOKUP, false, 1, "count"},
+      {TracePhase::CONVERT, true, 2, "count"},
+      {TracePhase::VALIDATE, true, 2, "count"},
+      {TracePhase::VALIDATE, false, 2, "count"},
+      {TracePhase::CONVERT, false, 2, "count"},
+      {TracePhase::REQUIRED_CHECK, true, -1, ""},
+      {TracePhase::REQUIRED_CHECK, false, -1, ""},
+  };
+  assert(trace.events.size() == sizeof(expected) / sizeof(expected[0]));
+  for (std::size_t i = 0; i < trace.events.size(); ++i) {
+    assert(trace.events[i].phase == expected[i].phase);
+    assert(trace.events[i].begin == expected[i].begin);
+    assert(trace.events[i].argvIndex == expected[i].argvIndex);
+    assert(trace.names[i] == expected[i].name);
+  }
+
+  // No handler installed: parsing is unaffected
+  trace.events.clear();
+  result = parser.parse(argc, const_cast<char**>(argv), nullptr);
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(trace.events.empty());
+
+  std::cout << "test_trace_hooks passed\n";
+}
+
+void test_parse_statistics() {
+  argsparser::Parser parser("test_app", "A test application");
+  parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  auto* count = parser.addArgument<int32_t>("count", "c", "Iterations");
+  count->setValidator([](int32_t value) { return value > 0; });
+
+  const char* argv[] = {"test_app", "--count", "5", "-v"};
+  const int argc = sizeof(argv) / sizeof(argv[0]);
+  auto result = parser.parse(argc, const_cast<char**>(argv), nullptr);
+  assert(result == argsparser::ParseResult::SUCCESS);
+
+  argsparser::ParseStatistics stats = parser.stats();
+  assert(stats.parseCalls == 1);
+  assert(stats.tokens == 3);
+  assert(stats.lookups == 2);
+  assert(stats.lookupMisses == 0);
+  assert(stats.conversions == 2);
+  assert(stats.validatorCalls == 1);
+
+  const char* badArgv[] = {"test_app", "--bogus"};
+  result = parser.parse(2, const_cast<char**>(badArgv), nullptr);
+  assert(result == argsparser::ParseResult::UNKNOWN_OPTION);
+
+  stats = parser.stats();
+  assert(stats.parseCalls == 2);
+  assert(stats.tokens == 4);
+  assert(stats.lookups == 3);
+  assert(stats.lookupMisses == 1);
+  std::uint64_t histogramTotal = 0;
+  for (const std::uint64_t bucket : stats.latencyBuckets) {
+    histogramTotal += bucket;
+  }
+  assert(histogramTotal == 2);
+
+  parser.resetStats();
+  stats = parser.stats();
+  assert(stats.parseCalls == 0);
+  assert(stats.tokens == 0);
+  assert(stats.phaseNanoseconds[static_cast<std::size_t>(
+             argsparser::TracePhase::CONVERT)] == 0);
+
+  std::cout << "test_parse_statistics passed\n";
+}
+
+void test_packed_flags() {
+  argsparser::Parser parser("test_app", "A test application");
+  parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+
+  constexpr std::size_t kFlagCount = 5000;
+  parser.reservePackedFlags(kFlagCount, kFlagCount * 16);
+  std::vector<std::size_t> indexes;
+  for (std::size_t i = 0; i < kFlagCount; ++i) {
+    indexes.push_back(parser.addPackedFlag("feature-" + std::to_string(i)));
+    assert(indexes.back() == i);
+  }
+  // Names already taken by an option or a packed flag are rejected
+  assert(parser.addPackedFlag("verbose") == argsparser::FlagSet::npos);
+  assert(parser.addPackedFlag("feature-7") == argsparser::FlagSet::npos);
+  assert(parser.getLastError() == "Duplicate option: --feature-7");
+  assert(parser.addPackedFlag("") == argsparser::FlagSet::npos);
+  assert(parser.addPackedFlag("feature=on") == argsparser::FlagSet::npos);
+  assert(parser.getLastError() == "Invalid packed flag name: feature=on");
+  // ...and so are options named like an existing packed flag
+  assert(parser.addArgument<bool>("feature-8", "", "Shadow") == nullptr);
+  assert(parser.getLastError() == "Duplicate option: --feature-8");
+  const argsparser::ArgumentDescriptor shadow[] = {
+      {argsparser::ArgumentType::BOOL, "feature-9", nullptr, "Shadow", false,
+       nullptr},
+  };
+  assert(!parser.addArguments(shadow));
+  assert(parser.getPackedFlags().size() == kFlagCount);
+  assert(parser.getPackedFlags().find("feature-4999") == 4999);
+  assert(parser.getPackedFlags().find("feature-5000") ==
+         argsparser::FlagSet::npos);
+
+  const char* argv[] = {"test_app", "--feature-0", "-v", "--feature-4321"};
+  const int argc = sizeof(argv) / sizeof(argv[0]);
+  auto result = parser.parse(argc, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(parser.isPackedFlagSet(indexes[0]));
+  assert(parser.isPackedFlagSet(indexes[4321]));
+  assert(!parser.isPackedFlagSet(indexes[1]));
+  assert(parser.isSet("feature-4321"));
+  assert(!parser.isSet("feature-4320"));
+  assert(parser.isSet("verbose"));
+
+  const char* unknownArgv[] = {"test_app", "--feature-9999"};
+  result = parser.parse(2, const_cast<char**>(unknownArgv));
+  assert(result == argsparser::ParseResult::UNKNOWN_OPTION);
+
+  // An explicit value is parsed as a boolean
+  const char* valueArgv[] = {"test_app", "--feature-0=false", "--feature-1=on"};
+  result = parser.parse(3, const_cast<char**>(valueArgv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(!parser.isPackedFlagSet(indexes[0]));
+  assert(parser.isPackedFlagSet(indexes[1]));
+
+  const char* badValueArgv[] = {"test_app", "--feature-2=maybe"};
+  result = parser.parse(2, const_cast<char**>(badValueArgv));
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(parser.getLastError() ==
+         "Invalid value for option: --feature-2 = maybe");
+  assert(!parser.isPackedFlagSet(indexes[2]));
+
+  // Name pool, offsets, bitset and hash slots stay well under 64 bytes each
+  assert(parser.getPackedFlags().memoryUsage() < kFlagCount * 64);
+
+  std::cout << "test_packed_flags passed\n";
+}
+
+void test_bulk_registration() {
+  using argsparser::ArgumentType;
+
+  argsparser::Parser parser("test_app", "A test application");
+  const argsparser::ArgumentDescriptor table[] = {
+      {ArgumentType::STRING, "output", "o", "Output file", false, "out.txt"},
+      {ArgumentType::BOOL, "verbose", "v", "Enable verbose output", false,
+       nullptr},
+      {ArgumentType::INT32, "count", "c", "Number of iterations", false, "10"},
+      {ArgumentType::DOUBLE, "ratio", nullptr, "Sampling ratio", false, "0.5"},
+      {ArgumentType::UINT64, "limit", nullptr, "Byte limit", true, nullptr},
+  };
+  assert(parser.addArguments(table));
+
+  // Defaults are applied without marking the options as given
+  assert(parser.getValue<std::string>("output") == "out.txt");
+  assert(parser.getValue<int32_t>("count") == 10);
+  assert(!parser.isSet("count"));
+
+  // Required options from the table are enforced
+  const char* missingArgv[] = {"test_app"};
+  auto result = parser.parse(1, const_cast<char**>(missingArgv));
+  assert(result == argsparser::ParseResult::MISSING_VALUE);
+
+  const char* argv[] = {"test_app", "-v", "--limit", "4096", "-c", "3"};
+  const int argc = sizeof(argv) / sizeof(argv[0]);
+  result = parser.parse(argc, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(parser.isSet("verbose"));
+  assert(parser.getValue<uint64_t>("limit") == 4096);
+  assert(parser.getValue<int32_t>("count") == 3);
+  assert(parser.getValue<double>("ratio") == 0.5);
+
+  // Duplicates within the table or against registered options register
+  // nothing
+  const argsparser::ArgumentDescriptor duplicates[] = {
+      {ArgumentType::INT32, "fresh", nullptr, "New option", false, nullptr},
+      {ArgumentType::INT32, "fresh", nullptr, "Same name", false, nullptr},
+  };
+  assert(!parser.addArguments(duplicates));
+  assert(parser.getLastError() == "Duplicate option: --fresh");
+  const argsparser::ArgumentDescriptor clash[] = {
+      {ArgumentType::BOOL, "quiet", "v", "Clashes with -v", false, nullptr},
+  };
+  assert(!parser.addArguments(clash));
+  assert(parser.getLastError() == "Duplicate option: -v");
+  const argsparser::ArgumentDescriptor badDefault[] = {
+      {ArgumentType::INT16, "level", nullptr, "Level", false, "99999"},
+  };
+  assert(!parser.addArguments(badDefault));
+  assert(parser.getLastError() ==
+         "Invalid default for option: --level = 99999");
+  assert(!parser.isSet("fresh"));
+
+  const char* freshArgv[] = {"test_app", "--fresh", "1"};
+  result = parser.parse(3, const_cast<char**>(freshArgv));
+  assert(result == argsparser::ParseResult::UNKNOWN_OPTION);
+
+  std::cout << "test_bulk_registration passed\n";
+}
+
+void test_argument_handles() {
+  argsparser::Parser parser("test_app", "A test application");
+  const argsparser::ArgumentHandle<int32_t> threads =
+      parser.addArgument<int32_t>("threads", "t", "Worker threads", false, 4);
+  parser.addArgument<std::string>("host", "H", "Server host");
+  parser.addPositionalArgument<std::string>("input", "Input file");
+  parser.addPackedFlag("feature-x");
+  const argsparser::ArgumentDescriptor table[] = {
+      {argsparser::ArgumentType::DOUBLE, "rate", "r", "Rate", false, "0.5"},
+  };
+  assert(parser.addArguments(table, 1));
+
+  const auto host = parser.getHandle<std::string>("host");
+  const auto input = parser.getHandle<std::string>("input");
+  const auto rate = parser.getHandle<double>("rate");
+  assert(threads && host && input && rate);
+  assert(!parser.getHandle<int64_t>("threads"));
+  assert(!parser.getHandle<int32_t>("missing"));
+  assert(threads.getValue() == 4 && !threads.isSet());
+  assert(rate.getValue() == 0.5);
+
+  const char* argv[] = {"test_app", "-t8", "--feature-x", "in.txt"};
+  auto result = parser.parse(4, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(threads.getValue() == 8 && threads.isSet());
+  assert(!host.isSet());
+  assert(input.getValue() == "in.txt");
+
+  // The name-based API resolves through the same index
+  assert(parser.getValue<int32_t>("threads") == 8);
+  assert(parser.getValue<std::string>("input") == "in.txt");
+  assert(parser.getValue<double>("rate") == 0.5);
+  assert(parser.getValue<int64_t>("threads") == 0);
+  assert(parser.isSet("threads") && parser.isSet("input"));
+  assert(parser.isSet("feature-x") && !parser.isSet("missing"));
+
+  std::cout << "test_argument_handles passed\n";
+}
+
+struct ThreadsKey : argsparser::Key<int32_t> {
+  static constexpr std::string_view name = "threads";
+  static constexpr std::string_view shortName = "t";
+  static constexpr std::string_view description = "Worker threads";
+  static constexpr int32_t defaultValue = 4;
+};
+
+struct HostKey : argsparser::Key<std::string> {
+  static constexpr std::string_view name = "host";
+  static constexpr std::string_view shortName = "H";
+  static constexpr std::string_view description = "Server host";
+  static constexpr std::string_view defaultValue = "localhost";
+};
+
+struct VerboseKey : argsparser::Key<bool> {
+  static constexpr std::string_view name = "verbose";
+  static constexpr std::string_view shortName = "v";
+};
+
+struct InputKey : argsparser::Key<std::string> {
+  static constexpr std::string_view name = "input";
+  static constexpr std::string_view description = "Input file";
+  static constexpr bool positional = true;
+  static constexpr bool required = true;
+};
+
+struct TimeoutKey : argsparser::Key<int32_t> {
+  static constexpr std::string_view name = "timeout";
+  static constexpr std::string_view shortName = "t";
+};
+
+void test_static_parser() {
+  using Schema =
+      argsparser::StaticParser<ThreadsKey, HostKey, VerboseKey, InputKey>;
+  // A short name shared by two keys is rejected like a shared long name
+  static_assert(argsparser::detail::keyNamesAreUnique<ThreadsKey, HostKey,
+                                                      VerboseKey, InputKey>());
+  static_assert(
+      !argsparser::detail::keyNamesAreUnique<ThreadsKey, TimeoutKey>());
+  static_assert(
+      !argsparser::detail::keyNamesAreUnique<ThreadsKey, ThreadsKey>());
+  Schema parser("test_app", "A test application");
+  static_assert(std::is_same_v<decltype(parser.get<ThreadsKey>()),
+                               const int32_t&>);
+  assert(parser.get<ThreadsKey>() == 4);
+  assert(parser.get<HostKey>() == "localhost");
+
+  const char* argv[] = {"test_app", "-v", "--threads=8", "in.txt"};
+  auto result = parser.parse(4, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(parser.get<ThreadsKey>() == 8 && parser.isSet<ThreadsKey>());
+  assert(parser.get<VerboseKey>() && !parser.isSet<HostKey>());
+  assert(parser.get<InputKey>() == "in.txt");
+#if ARGSPARSER_HAS_FIXED_STRING
+  assert(parser.get<"threads">() == 8 && parser.isSet<"verbose">());
+#endif
+
+  // Help and errors come from the wrapped parser, in key order
+  std::ostringstream help;
+  parser.parser().printHelp(help);
+  assert(help.str().find("Usage: test_app [OPTIONS] <input>") == 0);
+  assert(help.str().find("-t, --threads") < help.str().find("-H, --host"));
+  const char* missingArgv[] = {"test_app", "-v"};
+  result = parser.parse(2, const_cast<char**>(missingArgv));
+  assert(result == argsparser::ParseResult::MISSING_VALUE);
+
+  std::cout << "test_static_parser passed\n";
+}
+
+void test_string_storage() {
+  argsparser::Parser parser("test_app", "A test application");
+
+  // String literals are referenced on request, not copied
+  static const char kName[] = "level";
+  static const char kDescription[] = "Compression level for output files";
+  auto* level = parser.addArgument<int32_t>(
+      kName, "l", kDescription, false, 0, argsparser::StringStorage::REFERENCE);
+  assert(level->getNameView().data() == kName);
+  assert(level->getDescriptionView().data() == kDescription);
+
+  // C strings are copied by default, so they may point at temporaries
+  argsparser::Argument<int32_t>* jobs = nullptr;
+  argsparser::Argument<std::string>* source = nullptr;
+  {
+    std::string name = "jobs";
+    std::string description = "Number of parallel jobs";
+    jobs = parser.addArgument<int32_t>(name.c_str(), "j", description.c_str());
+    source = parser.addPositionalArgument<std::string>(
+        std::string("source").c_str(), std::string("Input file").c_str());
+    assert(jobs->getNameView().data() != name.data());
+    name.assign(name.size(), 'x');
+    description.clear();
+  }
+  assert(jobs->getName() == "jobs");
+  assert(jobs->getDescription() == "Number of parallel jobs");
+  assert(source->getName() == "source");
+
+  // getName() and friends still return std::string references, built once
+  const argsparser::MemoryUsage before = parser.memoryUsage();
+  const std::string& levelName = level->getName();
+  assert(std::strcmp(levelName.c_str(), "level") == 0);
+  assert(&level->getName() == &levelName);
+  assert(level->getShortName() == "l");
+  assert(parser.memoryUsage().strings > before.strings);
+
+  // std::string arguments are copied and may be temporaries
+  argsparser::Argument<std::string>* output = nullptr;
+  {
+    std::string name = "output-directory";
+    std::string description = "Directory that receives the generated files";
+    output = parser.addArgument<std::string>(name, std::string("o"),
+                                             description);
+    assert(output->getNameView().data() != name.data());
+    name.assign(name.size(), 'x');
+    description.clear();
+  }
+  assert(output->getName() == "output-directory");
+  assert(output->getDescription() ==
+         "Directory that receives the generated files");
+
+  // Descriptor tables copy their strings by default too
+  {
+    std::string name = "generated-option";
+    const argsparser::ArgumentDescriptor table[] = {
+        {argsparser::ArgumentType::BOOL, name.c_str(), nullptr,
+         "Generated at run time", false, nullptr},
+    };
+    assert(parser.addArguments(table));
+    name.assign(name.size(), 'x');
+  }
+
+  const char* argv[] = {"test_app", "--output-directory", "build",
+                        "--generated-option", "-l", "9", "--jobs", "4",
+                        "main.c"};
+  const int argc = sizeof(argv) / sizeof(argv[0]);
+  auto result = parser.parse(argc, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(output->getValue() == "build");
+  assert(parser.isSet("generated-option"));
+  assert(level->getValue() == 9);
+  assert(jobs->getValue() == 4);
+  assert(source->getValue() == "main.c");
+}
+
+void test_memory_usage() {
+  argsparser::Parser parser("app");
+  const argsparser::MemoryUsage empty = parser.memoryUsage();
+  assert(empty.argumentObjects == 0 && empty.strings == 0);
+  assert(empty.mapNodes == 0 && empty.positionalScratch == 0);
+
+  // Referenced names cost no string bytes, only the object and two map nodes
+  parser.addArgument<int32_t>("level", "l", "Compression level for output",
+                              false, 0, argsparser::StringStorage::REFERENCE);
+  const argsparser::MemoryUsage literal = parser.memoryUsage();
+  assert(literal.strings == 0);
+  assert(literal.argumentObjects >= sizeof(argsparser::ArgumentBase));
+  assert(literal.validators == sizeof(argsparser::InlineValidator<int32_t>));
+  assert(literal.mapNodes > 0 && literal.mapNodes % 2 == 0);
+  assert(literal.indexes > 0);
+
+  // Copied names are counted as one buffer per argument
+  const std::string name = "output";
+  const std::string description = "Output file";
+  parser.addArgument<std::string>(name, "o", description);
+  const argsparser::MemoryUsage copied = parser.memoryUsage();
+  assert(copied.strings == name.size() + 1 + description.size());
+  assert(copied.mapNodes == 2 * literal.mapNodes);
+
+  parser.addPositionalArgument<std::string>("source", "Source file");
+  parser.addPackedFlag("feature-x");
+  const argsparser::MemoryUsage full = parser.memoryUsage();
+  assert(full.positionalScratch >= sizeof(void*));
+  assert(full.packedFlags > 0);
+  assert(full.total() > copied.total());
+}
+
+void test_frozen_schema() {
+  argsparser::Parser parser("test_app", "A test application");
+  parser.addArgument<int32_t>("threads", "t", "Worker threads", false, 4);
+  parser.addArgument<std::string>("host", "H", "Server host", true);
+  parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  parser.addArgument<bool>("quiet", "q", "Suppress output");
+  parser.addArgument<double>("rate", "", "Rate", false, 0.1);
+  parser.addPositionalArgument<std::string>("input", "Input file");
+  std::string blob;
+  assert(parser.freezeSchema(blob));
+
+  // Written to disk and mapped back
+  const char* path = "test_argsparser_schema.bin";
+  std::FILE* file = std::fopen(path, "wb");
+  assert(file != nullptr);
+  std::fwrite(blob.data(), 1, blob.size(), file);
+  std::fclose(file);
+  argsparser::FrozenSchema schema;
+  const bool loaded = schema.load(path);
+  std::remove(path);
+  assert(loaded);
+  assert(schema.verify());
+  assert(schema.optionCount() == 5 && schema.positionalCount() == 1);
+  assert(schema.find("host") != argsparser::FrozenSchema::npos);
+  assert(schema.findShort("t") == schema.find("threads"));
+  assert(schema.find("missing") == argsparser::FrozenSchema::npos);
+  assert(schema.getDescription(schema.find("rate")) == "Rate");
+
+  std::ostringstream expectedHelp;
+  parser.printHelp(expectedHelp);
+  std::ostringstream help;
+  schema.printHelp(help);
+  assert(help.str() == expectedHelp.str());
+
+  argsparser::SchemaValues values;
+  const char* argv[] = {"test_app", "-vq",     "--host=example.org",
+                        "-t8",      "in.txt"};
+  const int argc = sizeof(argv) / sizeof(argv[0]);
+  auto result = schema.parse(argc, const_cast<char**>(argv), values);
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(schema.getValue<std::string>(values, "host") == "example.org");
+  assert(schema.getValue<int32_t>(values, "threads") == 8);
+  assert(schema.getValue<bool>(values, "quiet"));
+  assert(schema.getValue<double>(values, "rate") == 0.1);
+  assert(!schema.isSet(values, "rate"));
+  assert(schema.getValue<std::string>(values, "input") == "in.txt");
+  // Mismatched types read as T{}
+  assert(schema.getValue<int64_t>(values, "threads") == 0);
+
+  const char* badArgv[] = {"test_app", "--host", "h", "--threads", "many"};
+  result = schema.parse(5, const_cast<char**>(badArgv), values);
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(values.getLastError() == "Invalid value for option: --threads = many");
+  const char* missingArgv[] = {"test_app", "in.txt"};
+  result = schema.parse(2, const_cast<char**>(missingArgv), values);
+  assert(result == argsparser::ParseResult::MISSING_VALUE);
+
+  // Stale, truncated and corrupted blobs are rejected
+  argsparser::FrozenSchema other;
+  assert(other.attach(blob, schema.getHash()));
+  assert(!other.attach(blob, schema.getHash() + 1));
+  assert(other.getLastError().find("Stale") == 0);
+  assert(!other.attach(std::string_view(blob).substr(0, blob.size() - 1)));
+  std::string corrupted = blob;
+  corrupted.back() ^= 1;
+  assert(other.attach(corrupted) && !other.verify());
+  corrupted = blob;
+  corrupted[8] = 7;  // Layout version
+  assert(!other.attach(corrupted));
+  // An index entry pointing past the options (here at the positional)
+  corrupted = blob;
+  const std::size_t firstIndexEntry =
+      sizeof(argsparser::detail::FrozenHeader) +
+      6 * sizeof(argsparser::detail::FrozenRecord);
+  const std::uint32_t positionalRecord = 5;
+  std::memcpy(&corrupted[firstIndexEntry + 8], &positionalRecord,
+              sizeof(positionalRecord));
+  // Attaching stays constant time; the lookup and verify() catch it
+  assert(other.attach(corrupted));
+  assert(other.find("host") == argsparser::FrozenSchema::npos);
+  assert(other.find("quiet") != argsparser::FrozenSchema::npos);
+  assert(!other.verify());
+
+  // A re-registered long name and options without one leave fewer long
+  // index entries than options
+  argsparser::Parser sparse("test_app");
+  sparse.addArgument<int32_t>("level", "l", "Level");
+  sparse.addArgument<int32_t>("level", "L", "Level, registered again");
+  sparse.addArgument<bool>("", "x", "Short only");
+  sparse.addArgument<bool>("", "y", "Short only too");
+  std::string sparseBlob;
+  assert(sparse.freezeSchema(sparseBlob));
+  argsparser::FrozenSchema sparseSchema;
+  assert(sparseSchema.attach(sparseBlob) && sparseSchema.verify());
+  assert(sparseSchema.optionCount() == 4);
+  assert(sparseSchema.find("level") == 1);
+  assert(sparseSchema.findShort("l") == 0);
+  assert(sparseSchema.findShort("y") == 3);
+  assert(sparseSchema.getDescription(sparseSchema.findShort("L")) ==
+         "Level, registered again");
+}
+
+void registerTuning(argsparser::Parser& parser) {
+  parser.addArgument<int32_t>("threads", "t", "Worker threads", false, 1);
+  parser.addArgument<double>("rate", "r", "Rate", false, 1.0);
+}
+
+void writeFile(const char* path, const char* contents) {
+  std::FILE* file = std::fopen(path, "w");
+  assert(file != nullptr);
+  std::fputs(contents, file);
+  std::fclose(file);
+}
+
+void test_reloadable_config() {
+  const char* path = "test_argsparser_reload.ini";
+  writeFile(path, "threads = 4\n");
+  const char* argv[] = {"test_app", "--rate", "2.5"};
+  argsparser::ReloadableConfig config(path, registerTuning, 3,
+                                      const_cast<char**>(argv));
+  assert(config.read()->getGeneration() == 0);
+  assert(config.read()->getValue<int32_t>("threads") == 1);
+
+  assert(config.reload() == argsparser::ParseResult::SUCCESS);
+  {
+    const auto first = config.read();
+    assert(first->getGeneration() == 1);
+    assert(first->getValue<int32_t>("threads") == 4);
+    assert(first->getValue<double>("rate") == 2.5);  // argv still wins
+
+    // A bad file is rejected as a whole; readers keep the old snapshot
+    writeFile(path, "rate = 3\nthreads = lots\n");
+    assert(config.reload() == argsparser::ParseResult::INVALID_VALUE);
+    const argsparser::ReloadError error = config.getLastReloadError();
+    assert(error.location.line == 2 && error.location.column == 11);
+    assert(error.message == std::string(path) +
+                                ":2:11: invalid value for option 'threads'");
+    assert(error.generation == 1);
+    assert(config.read()->getGeneration() == 1);
+
+    // The replaced snapshot stays alive while a reader holds it
+    writeFile(path, "threads = 8\n");
+    assert(config.reload() == argsparser::ParseResult::SUCCESS);
+    assert(config.read()->getValue<int32_t>("threads") == 8);
+    assert(config.getLastReloadError().result ==
+           argsparser::ParseResult::SUCCESS);
+    assert(config.reclaim() == 1);
+    assert(first->getValue<int32_t>("threads") == 4);
+  }
+  assert(config.reclaim() == 0);
+
+  // Writes to the file are picked up by the watch; other files are ignored
+  if (config.watch()) {
+    assert(config.getWatchDescriptor() >= 0);
+    writeFile(path, "threads = 16\n");
+    assert(config.pollChanges(1000));
+    assert(config.read()->getValue<int32_t>("threads") == 16);
+    writeFile("test_argsparser_other.ini", "threads = 32\n");
+    std::remove("test_argsparser_other.ini");
+    assert(!config.pollChanges(0));
+    assert(config.read()->getGeneration() == 3);
+  }
+
+  // Help and completion requests in argv are not replayed on reload
+  writeFile(path, "threads = 4\n");
+  const char* helpArgv[] = {"test_app", "--help", "--rate", "2.5", "-h"};
+  argsparser::ReloadableConfig helped(path, registerTuning, 5,
+                                      const_cast<char**>(helpArgv));
+  assert(helped.reload() == argsparser::ParseResult::SUCCESS);
+  assert(helped.read()->getValue<int32_t>("threads") == 4);
+  assert(helped.read()->getValue<double>("rate") == 2.5);
+  const char* completeArgv[] = {"test_app", "--__complete", "--ra"};
+  argsparser::ReloadableConfig completed(path, registerTuning, 3,
+                                         const_cast<char**>(completeArgv));
+  assert(completed.reload() == argsparser::ParseResult::SUCCESS);
+  assert(completed.read()->getValue<double>("rate") == 1.0);
+  std::remove(path);
+
+  std::cout << "test_reloadable_config passed\n";
+}
+
+void registerService(argsparser::Parser& parser) {
+  parser.addArgument<int32_t>("threads", "t", "Worker threads", false, 1);
+  parser.addArgument<std::string>("host", "H", "Server host", false, "a");
+  parser.addArgument<bool>("verbose", "v", "Enable verbose output");
+  parser.addArgument<double>("rate", "r", "Rate", false, 1.0);
+}
+
+void recordChange(const argsparser::ReloadableConfig::ChangeEvent& event,
+                  void* context) {
+  static_cast<std::vector<std::string>*>(context)->emplace_back(event.name);
+}
+
+void test_change_observers() {
+  const char* path = "test_argsparser_observe.ini";
+  writeFile(path, "threads = 4\nhost = a\n");
+  argsparser::ReloadableConfig config(path, registerService);
+  std::vector<std::string> changes;
+  for (const char* name : {"threads", "host", "verbose", "rate"}) {
+    assert(config.observe(name, recordChange, &changes));
+  }
+  assert(!config.observe("missing", recordChange, &changes));
+
+  // host keeps its value but becomes set, so it counts as changed
+  assert(config.reload() == argsparser::ParseResult::SUCCESS);
+  assert((changes == std::vector<std::string>{"threads", "host"}));
+
+  // Rewriting the same values changes nothing
+  changes.clear();
+  assert(config.reload() == argsparser::ParseResult::SUCCESS);
+  assert(changes.empty());
+
+  changes.clear();
+  writeFile(path, "threads = 4\nhost = b\nverbose = true\n");
+  const auto before = config.read();
+  assert(config.reload() == argsparser::ParseResult::SUCCESS);
+  assert((changes == std::vector<std::string>{"host", "verbose"}));
+  const auto after = config.read();
+  const std::vector<std::size_t> changed =
+      argsparser::ReloadableConfig::diff(*before, *after);
+  assert((changed == std::vector<std::size_t>{after->indexOf("host"),
+                                              after->indexOf("verbose")}));
+  assert(argsparser::ReloadableConfig::diff(*after, *after).empty());
+
+  // Rejected reloads notify nobody
+  changes.clear();
+  writeFile(path, "threads = lots\n");
+  assert(config.reload() == argsparser::ParseResult::INVALID_VALUE);
+  assert(changes.empty());
+  std::remove(path);
+
+  std::cout << "test_change_observers passed\n";
+}
+
+void test_required_check_across_words() {
+  // More than 64 options, so the required bitset spans several words
+  argsparser::Parser parser("test_app", "A test application");
+  for (int i = 0; i < 130; ++i) {
+    const bool required = i == 70 || i == 129;
+    parser.addArgument<int32_t>("opt-" + std::to_string(i), "", "Option",
+                                required);
+  }
+
+  const char* argv[] = {"test_app", "--opt-70", "1"};
+  auto result = parser.parse(3, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::MISSING_VALUE);
+  assert(parser.getLastError() == "Missing required option: --opt-129");
+
+  // A value from a config file satisfies the requirement too
+  assert(parser.parseConfig("opt-129 = 5\n") ==
+         argsparser::ParseResult::SUCCESS);
+  result = parser.parse(3, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(parser.getValue<int32_t>("opt-129") == 5);
+
+  std::cout << "test_required_check_across_words passed\n";
+}
+
+void registerGrouped(argsparser::Parser& parser) {
+  using argsparser::GroupKind;
+  parser.addArgument<bool>("json", "j", "JSON output");
+  parser.addArgument<bool>("yaml", "y", "YAML output");
+  parser.addArgument<std::string>("user", "u", "User name");
+  parser.addArgument<std::string>("password", "p", "Password");
+  parser.addArgument<std::string>("input", "i", "Input file");
+  parser.addArgument<std::string>("url", "", "Input URL");
+  // Spread the members over two words of the set bitset
+  for (int i = 0; i < 70; ++i) {
+    parser.addArgument<int32_t>("filler-" + std::to_string(i), "", "Filler");
+  }
+  parser.addArgument<bool>("late", "l", "Option past the first word");
+  assert(parser.addOptionGroup(GroupKind::MUTUALLY_EXCLUSIVE,
+                               {"json", "yaml", "late"}));
+  assert(parser.addOptionGroup(GroupKind::ALL_OR_NONE, {"user", "password"}));
+  assert(parser.addOptionGroup(GroupKind::AT_LEAST_ONE, {"input", "url"}));
+}
+
+argsparser::ParseResult parseGrouped(std::vector<const char*> args,
+                                     std::string* error = nullptr) {
+  argsparser::Parser parser("test_app", "A test application");
+  registerGrouped(parser);
+  args.insert(args.begin(), "test_app");
+  const auto result = parser.parse(static_cast<int>(args.size()),
+                                   const_cast<char**>(args.data()), nullptr);
+  if (error != nullptr) {
+    *error = parser.getLastError();
+  }
+  return result;
+}
+
+void test_option_groups() {
+  using argsparser::GroupKind;
+  using argsparser::ParseResult;
+
+  std::string error;
+  assert(parseGrouped({"-j", "-u", "me", "-p", "pw", "--url=x"}) ==
+         ParseResult::SUCCESS);
+  assert(parseGrouped({"-i", "in.txt"}) == ParseResult::SUCCESS);
+
+  assert(parseGrouped({"-j", "-l", "-i", "x"}, &error) ==
+         ParseResult::INVALID_VALUE);
+  assert(error == "Options cannot be used together: --json, --late");
+  assert(parseGrouped({"-j"}, &error) == ParseResult::MISSING_VALUE);
+  assert(error == "One of these options is required: --input, --url");
+  assert(parseGrouped({"-i", "x", "-p", "pw"}, &error) ==
+         ParseResult::MISSING_VALUE);
+  assert(error == "Options must be used together: --user, --password");
+
+  // Values from config files count as given
+  argsparser::Parser parser("test_app", "A test application");
+  registerGrouped(parser);
+  assert(parser.parseConfig("url = x\n") == ParseResult::SUCCESS);
+  const char* argv[] = {"test_app"};
+  assert(parser.parse(1, const_cast<char**>(argv), nullptr) ==
+         ParseResult::SUCCESS);
+
+  assert(!parser.addOptionGroup(GroupKind::AT_LEAST_ONE, {"input", "nope"}));
+  assert(parser.getLastError() == "Unknown option in group: --nope");
+  assert(!parser.addOptionGroup(GroupKind::AT_LEAST_ONE, {"input"}));
+  assert(!parser.addOptionGroup(GroupKind::AT_LEAST_ONE, {"url", "url"}));
+
+  std::cout << "test_option_groups passed\n";
+}
+
 }  // namespace
 
 int main() {
@@ -276,12 +1678,38 @@ int main() {
   test_missing_value();
   test_invalid_value();
   test_validator();
+  test_capturing_validator();
+  test_oversized_validator();
+  test_custom_argument_type();
+  test_constraints();
+  test_environment_variables();
+  test_config_file();
+  test_config_file_errors();
+  test_subcommands();
+  test_shell_completion();
+  test_abbreviations();
+  test_unknown_option_suggestions();
+  test_allocation_budgets();
+  test_trace_hooks();
+  test_parse_statistics();
+  test_packed_flags();
+  test_bulk_registration();
+  test_argument_handles();
+  test_static_parser();
+  test_string_storage();
+  test_memory_usage();
+  test_frozen_schema();
+  test_reloadable_config();
+  test_change_observers();
+  test_required_check_across_words();
+  test_option_groups();
   test_print_help();
   test_unknown_option();
   test_equals_syntax();
   test_positional_arguments();
   test_missing_positional_argument();
   test_too_many_positional_arguments();
+  test_option_terminator();
   test_grouped_short_options();
   test_grouped_short_options_with_non_bool();
 
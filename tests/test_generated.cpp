@@ -0,0 +1,105 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "test_generated_options.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+namespace {
+using generated::ServerOptions;
+
+void test_generated_defaults() {
+  const ServerOptions options;
+  static_assert(std::is_same_v<decltype(ServerOptions::threads), int32_t>);
+  static_assert(
+      std::is_same_v<decltype(ServerOptions::host), std::string_view>);
+  assert(options.threads == 4);
+  assert(options.rate == 0.5);
+  assert(options.cache_size == 1048576U);
+  assert(options.default_ == "fallback");
+  assert(!options.verbose);
+
+  std::cout << "test_generated_defaults passed\n";
+}
+
+void test_generated_parse() {
+  ServerOptions options;
+  const char* argv[] = {"server",     "-vq",   "--host=example.org", "-t8",
+                        "--cache-size", "4096", "--default",         "x",
+                        "in.txt"};
+  const int argc = sizeof(argv) / sizeof(argv[0]);
+  auto result = options.parse(argc, const_cast<char**>(argv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(options.verbose && options.quiet);
+  assert(options.host == "example.org");
+  assert(options.threads == 8);
+  assert(options.cache_size == 4096U);
+  assert(options.default_ == "x");
+  assert(options.input == "in.txt");
+  assert(options.isSet(ServerOptions::Option::threads));
+  assert(!options.isSet(ServerOptions::Option::rate));
+
+  // Words after "--" are positional, even if they look like options
+  ServerOptions terminated;
+  const char* terminatedArgv[] = {"server", "-H", "h", "--", "--help"};
+  result = terminated.parse(5, const_cast<char**>(terminatedArgv));
+  assert(result == argsparser::ParseResult::SUCCESS);
+  assert(terminated.input == "--help");
+
+  std::cout << "test_generated_parse passed\n";
+}
+
+void test_generated_errors() {
+  // Conversion follows Argument<T>: int16 overflow is rejected
+  ServerOptions options;
+  const char* overflowArgv[] = {"server", "-H", "h", "--hops", "40000"};
+  auto result = options.parse(5, const_cast<char**>(overflowArgv));
+  assert(result == argsparser::ParseResult::INVALID_VALUE);
+  assert(std::string(options.error.message) == "Invalid value for option");
+  assert(options.error.argument == "40000");
+
+  ServerOptions unknown;
+  const char* unknownArgv[] = {"server", "--hots", "x"};
+  result = unknown.parse(3, const_cast<char**>(unknownArgv));
+  assert(result == argsparser::ParseResult::UNKNOWN_OPTION);
+  assert(unknown.error.argument == "--hots");
+
+  ServerOptions missing;
+  const char* missingArgv[] = {"server", "-v"};
+  result = missing.parse(2, const_cast<char**>(missingArgv));
+  assert(result == argsparser::ParseResult::MISSING_VALUE);
+  assert(missing.error.argument == "host");
+
+  ServerOptions help;
+  const char* helpArgv[] = {"server", "--help"};
+  result = help.parse(2, const_cast<char**>(helpArgv));
+  assert(result == argsparser::ParseResult::HELP_REQUESTED);
+
+  std::cout << "test_generated_errors passed\n";
+}
+
+void test_generated_help() {
+  // The help text is rendered by the same code as Parser::printHelp()
+  const std::string help = ServerOptions::kHelp;
+  assert(help.find("Usage: server [OPTIONS] <input>") == 0);
+  assert(help.find("-t, --threads") != std::string::npos);
+  assert(help.find("Generated parser test") != std::string::npos);
+
+  std::cout << "test_generated_help passed\n";
+}
+}  // namespace
+
+int main() {
+  test_generated_defaults();
+  test_generated_parse();
+  test_generated_errors();
+  test_generated_help();
+
+  std::cout << "All generated parser tests passed!\n";
+  return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-const-cast)
@@ -0,0 +1,873 @@
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "argsparser.hpp"
+
+// Generates a specialized parser header from a JSON option spec; see the
+// "Generated Parsers" section of README.md for the spec format.
+
+namespace {
+
+/**
+ * @brief A parsed JSON value (numbers are kept as their source text)
+ */
+struct JsonValue {
+  enum class Kind : std::uint8_t { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+  Kind kind{Kind::NUL};
+  bool boolean{false};
+  std::string text;  // STRING contents or NUMBER source text
+  std::vector<JsonValue> items;
+  std::vector<std::pair<std::string, JsonValue>> members;
+
+  [[nodiscard]] const JsonValue* member(const std::string& key) const {
+    for (const auto& entry : members) {
+      if (entry.first == key) {
+        return &entry.second;
+      }
+    }
+    return nullptr;
+  }
+};
+
+/**
+ * @brief Recursive-descent reader for the JSON subset used by option specs
+ */
+class JsonReader {
+ private:
+  std::string_view input_;
+  std::size_t pos_{0};
+  std::string error_;
+
+  void skipSpace() {
+    while (pos_ < input_.size() &&
+           (input_[pos_] == ' ' || input_[pos_] == '\t' ||
+            input_[pos_] == '\n' || input_[pos_] == '\r')) {
+      ++pos_;
+    }
+  }
+
+  bool skipComma() {
+    skipSpace();
+    if (pos_ < input_.size() && input_[pos_] == ',') {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  bool fail(const std::string& message) {
+    if (error_.empty()) {
+      const std::size_t line =
+          1 + static_cast<std::size_t>(std::count(
+                  input_.begin(),
+                  input_.begin() + static_cast<std::ptrdiff_t>(pos_), '\n'));
+      error_ = "line " + std::to_string(line) + ": " + message;
+    }
+    return false;
+  }
+
+  bool expect(char c) {
+    skipSpace();
+    if (pos_ >= input_.size() || input_[pos_] != c) {
+      return fail(std::string("expected '") + c + "'");
+    }
+    ++pos_;
+    return true;
+  }
+
+  bool readString(std::string& out) {
+    if (!expect('"')) {
+      return false;
+    }
+    out.clear();
+    while (pos_ < input_.size() && input_[pos_] != '"') {
+      char c = input_[pos_++];
+      if (c == '\\') {
+        if (pos_ >= input_.size()) {
+          break;
+        }
+        c = input_[pos_++];
+        switch (c) {
+          case 'n':
+            c = '\n';
+            break;
+          case 't':
+            c = '\t';
+            break;
+          case 'r':
+            c = '\r';
+            break;
+          case 'u': {
+            // Only code points below 0x80 are needed for option specs
+            unsigned code = 0;
+            if (pos_ + 4 > input_.size() ||
+                std::sscanf(std::string(input_.substr(pos_, 4)).c_str(), "%4x",
+                            &code) != 1 ||
+                code >= 0x80) {
+              return fail("unsupported \\u escape");
+            }
+            pos_ += 4;
+            c = static_cast<char>(code);
+            break;
+          }
+          default:
+            break;  // \" \\ \/ stand for themselves
+        }
+      }
+      out += c;
+    }
+    if (pos_ >= input_.size()) {
+      return fail("unterminated string");
+    }
+    ++pos_;
+    return true;
+  }
+
+  bool readValue(JsonValue& value) {
+    skipSpace();
+    if (pos_ >= input_.size()) {
+      return fail("unexpected end of input");
+    }
+    const char c = input_[pos_];
+    if (c == '"') {
+      value.kind = JsonValue::Kind::STRING;
+      return readString(value.text);
+    }
+    if (c == '{') {
+      ++pos_;
+      value.kind = JsonValue::Kind::OBJECT;
+      skipSpace();
+      if (pos_ < input_.size() && input_[pos_] == '}') {
+        ++pos_;
+        return true;
+      }
+      for (;;) {
+        std::pair<std::string, JsonValue> entry;
+        if (!readString(entry.first) || !expect(':') ||
+            !readValue(entry.second)) {
+          return false;
+        }
+        value.members.push_back(std::move(entry));
+        if (!skipComma()) {
+          return expect('}');
+        }
+      }
+    }
+    if (c == '[') {
+      ++pos_;
+      value.kind = JsonValue::Kind::ARRAY;
+      skipSpace();
+      if (pos_ < input_.size() && input_[pos_] == ']') {
+        ++pos_;
+        return true;
+      }
+      for (;;) {
+        value.items.emplace_back();
+        if (!readValue(value.items.back())) {
+          return false;
+        }
+        if (!skipComma()) {
+          return expect(']');
+        }
+      }
+    }
+    for (const char* word : {"true", "false", "null"}) {
+      const std::string_view keyword(word);
+      if (input_.substr(pos_, keyword.size()) == keyword) {
+        pos_ += keyword.size();
+        value.kind = keyword == "null" ? JsonValue::Kind::NUL
+                                       : JsonValue::Kind::BOOL;
+        value.boolean = keyword == "true";
+        return true;
+      }
+    }
+    const std::size_t start = pos_;
+    while (pos_ < input_.size() &&
+           std::string_view("+-.0123456789eE").find(input_[pos_]) !=
+               std::string_view::npos) {
+      ++pos_;
+    }
+    if (pos_ == start) {
+      return fail(std::string("unexpected character '") + c + "'");
+    }
+    value.kind = JsonValue::Kind::NUMBER;
+    value.text = std::string(input_.substr(start, pos_ - start));
+    return true;
+  }
+
+ public:
+  explicit JsonReader(std::string_view input) : input_(input) {}
+
+  bool read(JsonValue& value) {
+    if (!readValue(value)) {
+      return false;
+    }
+    skipSpace();
+    return pos_ == input_.size() || fail("trailing characters");
+  }
+
+  [[nodiscard]] const std::string& error() const { return error_; }
+};
+
+/**
+ * @brief One option or positional argument of the spec
+ */
+struct OptionSpec {
+  std::string name;
+  std::string shortName;
+  std::string description;
+  std::string defaultValue;  // Command-line syntax; empty for none
+  argsparser::ArgumentType type{argsparser::ArgumentType::STRING};
+  bool required{false};
+  std::string field;  // C++ member name
+};
+
+/**
+ * @brief The whole spec
+ */
+struct Spec {
+  std::string structName;
+  std::string namespaceName;
+  std::string program;
+  std::string description;
+  std::vector<OptionSpec> options;
+  std::vector<OptionSpec> positionals;
+};
+
+struct TypeInfo {
+  const char* specName;
+  argsparser::ArgumentType type;
+  const char* cppType;
+};
+
+constexpr std::array<TypeInfo, 9> kTypes{{
+    {"bool", argsparser::ArgumentType::BOOL, "bool"},
+    {"string", argsparser::ArgumentType::STRING, "std::string_view"},
+    {"int16", argsparser::ArgumentType::INT16, "std::int16_t"},
+    {"uint32", argsparser::ArgumentType::UINT32, "std::uint32_t"},
+    {"int32", argsparser::ArgumentType::INT32, "std::int32_t"},
+    {"uint64", argsparser::ArgumentType::UINT64, "std::uint64_t"},
+    {"int64", argsparser::ArgumentType::INT64, "std::int64_t"},
+    {"float", argsparser::ArgumentType::FLOAT, "float"},
+    {"double", argsparser::ArgumentType::DOUBLE, "double"},
+}};
+
+const TypeInfo& typeInfo(argsparser::ArgumentType type) {
+  return kTypes[static_cast<std::size_t>(type)];
+}
+
+/**
+ * @brief Turn an option name into a C++ identifier
+ *
+ * Characters other than letters and digits become '_'. Names that clash
+ * with C++ keywords or members of the generated struct get a trailing '_'.
+ */
+std::string fieldName(const std::string& name) {
+  static const std::array<const char*, 32> reserved{
+      "assign",   "auto",      "bool",   "break",    "case",     "char",
+      "class",    "clearSet",  "const",  "default",  "delete",   "do",
+      "double",   "else",      "enum",   "error",    "false",    "findLong",
+      "findShort", "float",    "for",    "if",       "int",      "isFlag",
+      "isRequired", "isSet",   "nameOf", "new",      "Option",   "parse",
+      "return",   "true"};
+  std::string field;
+  for (const char c : name) {
+    const bool isAlnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                         (c >= '0' && c <= '9');
+    field += isAlnum ? c : '_';
+  }
+  if (field.empty() || (field[0] >= '0' && field[0] <= '9')) {
+    field.insert(0, "_");
+  }
+  for (const char* word : reserved) {
+    if (field == word) {
+      field += '_';
+    }
+  }
+  return field;
+}
+
+bool readOption(const JsonValue& entry, bool positional, OptionSpec& option,
+                std::string& error) {
+  if (entry.kind != JsonValue::Kind::OBJECT) {
+    error = "options and positionals must be objects";
+    return false;
+  }
+  const JsonValue* name = entry.member("name");
+  if (name == nullptr || name->kind != JsonValue::Kind::STRING) {
+    error = "every option needs a \"name\" string";
+    return false;
+  }
+  option.name = name->text;
+  if (const JsonValue* shortName = entry.member("short")) {
+    if (positional) {
+      error = "positional argument " + option.name + " cannot have \"short\"";
+      return false;
+    }
+    option.shortName = shortName->text;
+  }
+  if (const JsonValue* description = entry.member("description")) {
+    option.description = description->text;
+  }
+  const JsonValue* type = entry.member("type");
+  const std::string typeName = type != nullptr ? type->text : "string";
+  const auto* info = std::find_if(
+      kTypes.begin(), kTypes.end(),
+      [&](const TypeInfo& candidate) {
+        return typeName == candidate.specName;
+      });
+  if (info == kTypes.end()) {
+    error = "unknown type \"" + typeName + "\" for " + option.name;
+    return false;
+  }
+  option.type = info->type;
+  if (const JsonValue* required = entry.member("required")) {
+    option.required = required->boolean;
+  } else {
+    option.required = positional;
+  }
+  if (const JsonValue* defaultValue = entry.member("default")) {
+    if (defaultValue->kind == JsonValue::Kind::BOOL) {
+      option.defaultValue = defaultValue->boolean ? "true" : "";
+    } else {
+      option.defaultValue = defaultValue->text;
+    }
+  }
+  option.field = fieldName(option.name);
+  return true;
+}
+
+bool readSpec(const JsonValue& root, Spec& spec, std::string& error) {
+  const JsonValue* structName = root.member("struct");
+  if (root.kind != JsonValue::Kind::OBJECT || structName == nullptr ||
+      fieldName(structName->text) != structName->text) {
+    error = "the spec needs a \"struct\" name that is a C++ identifier";
+    return false;
+  }
+  spec.structName = structName->text;
+  if (const JsonValue* ns = root.member("namespace")) {
+    spec.namespaceName = ns->text;
+  }
+  const JsonValue* program = root.member("program");
+  spec.program = program != nullptr ? program->text : spec.structName;
+  if (const JsonValue* description = root.member("description")) {
+    spec.description = description->text;
+  }
+  for (const char* section : {"options", "positionals"}) {
+    const JsonValue* list = root.member(section);
+    if (list == nullptr) {
+      continue;
+    }
+    const bool positional = std::string_view(section) == "positionals";
+    for (const JsonValue& entry : list->items) {
+      OptionSpec option;
+      if (!readOption(entry, positional, option, error)) {
+        return false;
+      }
+      (positional ? spec.positionals : spec.options).push_back(option);
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool addPositional(argsparser::Parser& parser, const OptionSpec& option) {
+  T value{};
+  if (!option.defaultValue.empty() &&
+      !argsparser::convertValue(option.defaultValue, value)) {
+    return false;
+  }
+  parser.addPositionalArgument<T>(option.name, option.description,
+                                  option.required, value,
+                                  argsparser::StringStorage::REFERENCE);
+  return true;
+}
+
+/**
+ * @brief Register the spec with a Parser, which checks names and defaults
+ * and renders the help text
+ */
+bool buildParser(const Spec& spec, argsparser::Parser& parser,
+                 std::string& error) {
+  std::vector<argsparser::ArgumentDescriptor> table;
+  for (const OptionSpec& option : spec.options) {
+    table.push_back({option.type, option.name.c_str(),
+                     option.shortName.empty() ? nullptr
+                                              : option.shortName.c_str(),
+                     option.description.c_str(), option.required,
+                     option.defaultValue.empty()
+                         ? nullptr
+                         : option.defaultValue.c_str()});
+  }
+  if (!parser.addArguments(table.data(), table.size())) {
+    error = parser.getLastError();
+    return false;
+  }
+  for (const OptionSpec& option : spec.positionals) {
+    bool added = false;
+    switch (option.type) {
+      case argsparser::ArgumentType::STRING:
+        added = addPositional<std::string>(parser, option);
+        break;
+      case argsparser::ArgumentType::INT16:
+        added = addPositional<int16_t>(parser, option);
+        break;
+      case argsparser::ArgumentType::UINT32:
+        added = addPositional<uint32_t>(parser, option);
+        break;
+      case argsparser::ArgumentType::INT32:
+        added = addPositional<int32_t>(parser, option);
+        break;
+      case argsparser::ArgumentType::UINT64:
+        added = addPositional<uint64_t>(parser, option);
+        break;
+      case argsparser::ArgumentType::INT64:
+        added = addPositional<int64_t>(parser, option);
+        break;
+      case argsparser::ArgumentType::FLOAT:
+        added = addPositional<float>(parser, option);
+        break;
+      case argsparser::ArgumentType::DOUBLE:
+        added = addPositional<double>(parser, option);
+        break;
+      case argsparser::ArgumentType::BOOL:
+        error = "positional argument " + option.name + " cannot be a bool";
+        return false;
+    }
+    if (!added) {
+      error = "Invalid default for positional argument: " + option.name +
+              " = " + option.defaultValue;
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string quote(std::string_view text) {
+  std::string out = "\"";
+  for (const char c : text) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          std::array<char, 8> escaped{};
+          std::snprintf(escaped.data(), escaped.size(), "\\%03o",
+                        static_cast<unsigned>(static_cast<unsigned char>(c)));
+          out += escaped.data();
+        } else {
+          out += c;
+        }
+    }
+  }
+  return out + "\"";
+}
+
+std::string quoteChar(char c) {
+  if (c == '\'' || c == '\\') {
+    return std::string("'\\") + c + "'";
+  }
+  if (static_cast<unsigned char>(c) < 0x20 ||
+      static_cast<unsigned char>(c) >= 0x7F) {
+    std::array<char, 8> escaped{};
+    std::snprintf(escaped.data(), escaped.size(), "'\\x%02x'",
+                  static_cast<unsigned>(static_cast<unsigned char>(c)));
+    return escaped.data();
+  }
+  return std::string("'") + c + "'";
+}
+
+/**
+ * @brief The C++ initializer for an option's default value
+ */
+std::string initializer(const OptionSpec& option) {
+  std::array<char, 64> buffer{};
+  switch (option.type) {
+    case argsparser::ArgumentType::BOOL: {
+      // An empty text means "no default" here, not "true"
+      bool value = false;
+      if (!option.defaultValue.empty()) {
+        argsparser::convertValue(option.defaultValue, value);
+      }
+      return value ? "true" : "false";
+    }
+    case argsparser::ArgumentType::STRING:
+      return option.defaultValue.empty() ? "" : quote(option.defaultValue);
+    case argsparser::ArgumentType::FLOAT:
+    case argsparser::ArgumentType::DOUBLE: {
+      double value = 0.0;
+      argsparser::convertValue(option.defaultValue, value);
+      const char* cppType = typeInfo(option.type).cppType;
+      if (std::isnan(value)) {
+        return std::string("std::numeric_limits<") + cppType +
+               ">::quiet_NaN()";
+      }
+      if (std::isinf(value)) {
+        return std::string(value < 0 ? "-" : "") + "std::numeric_limits<" +
+               cppType + ">::infinity()";
+      }
+      if (option.type == argsparser::ArgumentType::FLOAT) {
+        float narrow = 0.0F;
+        argsparser::convertValue(option.defaultValue, narrow);
+        std::snprintf(buffer.data(), buffer.size(), "%.9gF",
+                      static_cast<double>(narrow));
+      } else {
+        std::snprintf(buffer.data(), buffer.size(), "%.17g", value);
+      }
+      // Make sure the literal is a floating-point one (e.g., "1" -> "1.0")
+      std::string literal = buffer.data();
+      if (literal.find_first_of(".e") == std::string::npos) {
+        const std::size_t suffix = literal.find('F');
+        literal.insert(suffix == std::string::npos ? literal.size() : suffix,
+                       ".0");
+      }
+      return literal;
+    }
+    case argsparser::ArgumentType::UINT32:
+    case argsparser::ArgumentType::UINT64: {
+      std::uint64_t value = 0;
+      argsparser::convertValue(option.defaultValue, value);
+      std::snprintf(buffer.data(), buffer.size(), "%" PRIu64 "U", value);
+      return buffer.data();
+    }
+    case argsparser::ArgumentType::INT16:
+    case argsparser::ArgumentType::INT32:
+    case argsparser::ArgumentType::INT64:
+      break;
+  }
+  std::int64_t value = 0;
+  argsparser::convertValue(option.defaultValue, value);
+  if (value == INT64_MIN) {
+    return "INT64_MIN";
+  }
+  std::snprintf(buffer.data(), buffer.size(), "%" PRId64, value);
+  return buffer.data();
+}
+
+/**
+ * @brief Emit a function body mapping names to indexes with a switch on the
+ * length and then on the first byte
+ */
+void emitLookup(std::ostream& out, const std::map<std::string, int>& names) {
+  using Entries = std::vector<std::pair<std::string, int>>;
+  std::map<std::size_t, std::map<char, Entries>> groups;
+  for (const auto& [name, index] : names) {
+    groups[name.size()][name[0]].emplace_back(name, index);
+  }
+  if (groups.empty()) {
+    out << "    static_cast<void>(name);\n";
+  } else {
+    out << "    switch (name.size()) {\n";
+    for (const auto& [length, byFirst] : groups) {
+      out << "      case " << length << ":\n"
+          << "        switch (name[0]) {\n";
+      for (const auto& [first, entries] : byFirst) {
+        out << "          case " << quoteChar(first) << ":\n";
+        for (const auto& [name, index] : entries) {
+          out << "            if (name == " << quote(name) << ") {\n"
+              << "              return " << index << ";\n"
+              << "            }\n";
+        }
+        out << "            break;\n";
+      }
+      out << "          default:\n"
+          << "            break;\n"
+          << "        }\n"
+          << "        break;\n";
+    }
+    out << "      default:\n"
+        << "        break;\n"
+        << "    }\n";
+  }
+  out << "    return -1;\n";
+}
+
+/**
+ * @brief Emit a constexpr predicate over record indexes
+ */
+void emitPredicate(std::ostream& out, const char* name,
+                   const std::vector<int>& matches) {
+  out << "  static constexpr bool " << name << "(int index) {\n";
+  if (matches.empty()) {
+    out << "    static_cast<void>(index);\n"
+        << "    return false;\n";
+  } else {
+    out << "    switch (index) {\n";
+    for (const int index : matches) {
+      out << "      case " << index << ":\n";
+    }
+    out << "        return true;\n"
+        << "      default:\n"
+        << "        return false;\n"
+        << "    }\n";
+  }
+  out << "  }\n";
+}
+
+void emitHeader(const Spec& spec, const std::string& specName,
+                const std::string& help, std::ostream& out) {
+  std::vector<const OptionSpec*> records;
+  for (const OptionSpec& option : spec.options) {
+    records.push_back(&option);
+  }
+  for (const OptionSpec& option : spec.positionals) {
+    records.push_back(&option);
+  }
+  const std::size_t words =
+      std::max<std::size_t>(1, (records.size() + 63) / 64);
+
+  std::string guard = "ARGSPARSER_GENERATED_" + fieldName(spec.structName);
+  std::transform(guard.begin(), guard.end(), guard.begin(), [](char c) {
+    return static_cast<char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+  });
+  guard += "_HPP";
+
+  out << "// Generated by argsparser_generate from " << specName
+      << ". Do not edit.\n"
+      << "#ifndef " << guard << "\n"
+      << "#define " << guard << "\n\n"
+      << "#include <array>\n"
+      << "#include <cstdint>\n"
+      << "#include <limits>\n"
+      << "#include <string_view>\n\n"
+      << "#include \"argsparser.hpp\"\n\n";
+  if (!spec.namespaceName.empty()) {
+    out << "namespace " << spec.namespaceName << " {\n\n";
+  }
+
+  out << "/**\n"
+      << " * @brief " << (spec.description.empty() ? spec.program
+                                                    : spec.description)
+      << "\n"
+      << " *\n"
+      << " * Call parse() on a fresh object; string fields refer to argv.\n"
+      << " */\n"
+      << "struct " << spec.structName << " {\n";
+  for (const OptionSpec* option : records) {
+    out << "  " << typeInfo(option->type).cppType << " " << option->field
+        << "{" << initializer(*option) << "};";
+    if (!option->description.empty()) {
+      out << "  ///< " << option->description;
+    }
+    out << "\n";
+  }
+
+  out << "\n  /// Options, then positional arguments, in spec order\n"
+      << "  enum class Option : int {\n";
+  for (const OptionSpec* option : records) {
+    out << "    " << option->field << ",\n";
+  }
+  out << "  };\n\n"
+      << "  static constexpr int kOptionCount = " << spec.options.size()
+      << ";\n"
+      << "  static constexpr int kPositionalCount = "
+      << spec.positionals.size() << ";\n\n"
+      << "  /// Help text, as printed by argsparser::Parser::printHelp()\n"
+      << "  static constexpr const char* kHelp =\n";
+  std::size_t lineStart = 0;
+  while (lineStart < help.size()) {
+    const std::size_t lineEnd = help.find('\n', lineStart);
+    const std::size_t next =
+        lineEnd == std::string::npos ? help.size() : lineEnd + 1;
+    out << "      " << quote(help.substr(lineStart, next - lineStart))
+        << (next == help.size() ? ";\n" : "\n");
+    lineStart = next;
+  }
+  if (help.empty()) {
+    out << "      \"\";\n";
+  }
+
+  out << "\n  argsparser::GeneratedError error;  ///< Set when parse() fails"
+      << "\n\n"
+      << "  /**\n"
+      << "   * @brief Parse command-line arguments into the fields\n"
+      << "   * @param argc The number of command-line arguments\n"
+      << "   * @param argv The array of command-line argument strings\n"
+      << "   * @return argsparser::ParseResult The result of the parsing "
+         "operation\n"
+      << "   */\n"
+      << "  argsparser::ParseResult parse(int argc, char** argv) {\n"
+      << "    return argsparser::parseGenerated(*this, argc, argv);\n"
+      << "  }\n\n"
+      << "  /**\n"
+      << "   * @brief Check whether an option was given on the command line\n"
+      << "   * @param option The option\n"
+      << "   * @return true if it was given, false otherwise\n"
+      << "   */\n"
+      << "  [[nodiscard]] bool isSet(Option option) const {\n"
+      << "    return isSet(static_cast<int>(option));\n"
+      << "  }\n\n"
+      << "  // Used by argsparser::parseGenerated()\n";
+
+  std::map<std::string, int> longNames;
+  std::map<std::string, int> shortNames;
+  std::vector<int> flags;
+  std::vector<int> required;
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    const OptionSpec& option = *records[i];
+    const int index = static_cast<int>(i);
+    if (i < spec.options.size()) {
+      longNames[option.name] = index;
+      if (!option.shortName.empty()) {
+        shortNames[option.shortName] = index;
+      }
+    }
+    if (option.type == argsparser::ArgumentType::BOOL) {
+      flags.push_back(index);
+    } else if (option.required) {
+      required.push_back(index);
+    }
+  }
+  out << "  static int findLong(std::string_view name) {\n";
+  emitLookup(out, longNames);
+  out << "  }\n\n"
+      << "  static int findShort(std::string_view name) {\n";
+  emitLookup(out, shortNames);
+  out << "  }\n\n";
+  emitPredicate(out, "isFlag", flags);
+  out << "\n";
+  emitPredicate(out, "isRequired", required);
+
+  out << "\n  static constexpr std::string_view nameOf(int index) {\n"
+      << "    switch (index) {\n";
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    out << "      case " << i << ":\n"
+        << "        return " << quote(records[i]->name) << ";\n";
+  }
+  out << "      default:\n"
+      << "        return {};\n"
+      << "    }\n"
+      << "  }\n\n"
+      << "  bool assign(int index, std::string_view value) {\n"
+      << "    bool converted = false;\n"
+      << "    switch (index) {\n";
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    const OptionSpec& option = *records[i];
+    out << "      case " << i << ":\n";
+    if (option.type == argsparser::ArgumentType::STRING) {
+      out << "        " << option.field << " = value;\n"
+          << "        converted = true;\n";
+    } else {
+      out << "        converted = argsparser::convertValue(value, "
+          << option.field << ");\n";
+    }
+    out << "        break;\n";
+  }
+  out << "      default:\n"
+      << "        break;\n"
+      << "    }\n"
+      << "    if (converted) {\n"
+      << "      set_[static_cast<std::size_t>(index) / 64] |=\n"
+      << "          std::uint64_t{1} << (static_cast<unsigned>(index) % 64);\n"
+      << "    }\n"
+      << "    return converted;\n"
+      << "  }\n\n"
+      << "  [[nodiscard]] bool isSet(int index) const {\n"
+      << "    return ((set_[static_cast<std::size_t>(index) / 64] >>\n"
+      << "             (static_cast<unsigned>(index) % 64)) &\n"
+      << "            1U) != 0;\n"
+      << "  }\n\n"
+      << "  void clearSet() { set_.fill(0); }\n\n"
+      << " private:\n"
+      << "  std::array<std::uint64_t, " << words << "> set_{};\n"
+      << "};\n";
+  if (!spec.namespaceName.empty()) {
+    out << "\n}  // namespace " << spec.namespaceName << "\n";
+  }
+  out << "\n#endif  // " << guard << "\n";
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  argsparser::Parser tool(
+      "argsparser_generate",
+      "Generate a specialized argument parser header from a JSON option spec");
+  auto* specPath =
+      tool.addPositionalArgument<std::string>("spec", "JSON option spec");
+  auto* outputPath =
+      tool.addPositionalArgument<std::string>("output", "Header to write");
+  const argsparser::ParseResult result = tool.parse(argc, argv);
+  if (result == argsparser::ParseResult::HELP_REQUESTED) {
+    tool.printHelp();
+    return 0;
+  }
+  if (result != argsparser::ParseResult::SUCCESS) {
+    std::cerr << "argsparser_generate: " << tool.getLastError() << "\n";
+    return 1;
+  }
+
+  const std::string& path = specPath->getValue();
+  std::ifstream input(path);
+  if (!input) {
+    std::cerr << "argsparser_generate: cannot read " << path << "\n";
+    return 1;
+  }
+  std::ostringstream contents;
+  contents << input.rdbuf();
+  const std::string text = contents.str();
+
+  JsonValue root;
+  JsonReader reader(text);
+  Spec spec;
+  std::string error;
+  if (!reader.read(root)) {
+    error = reader.error();
+  } else {
+    readSpec(root, spec, error);
+  }
+
+  argsparser::Parser parser(spec.program, spec.description);
+  if (error.empty()) {
+    buildParser(spec, parser, error);
+  }
+  std::map<std::string, std::string> fields;
+  for (const auto* list : {&spec.options, &spec.positionals}) {
+    for (const OptionSpec& option : *list) {
+      if (error.empty() && !fields.emplace(option.field, option.name).second) {
+        error = "options " + fields[option.field] + " and " + option.name +
+                " map to the same field " + option.field;
+      }
+    }
+  }
+  if (!error.empty()) {
+    std::cerr << "argsparser_generate: " << path << ": " << error << "\n";
+    return 1;
+  }
+
+  std::ostringstream help;
+  parser.printHelp(help);
+  std::ostringstream header;
+  const std::size_t slash = path.find_last_of("/\\");
+  emitHeader(spec, slash == std::string::npos ? path : path.substr(slash + 1),
+             help.str(), header);
+
+  std::ofstream output(outputPath->getValue());
+  output << header.str();
+  if (!output) {
+    std::cerr << "argsparser_generate: cannot write "
+              << outputPath->getValue() << "\n";
+    return 1;
+  }
+  return 0;
+}